@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "unrolled_list.h"
+
+// Флаги побайтно (unrolled_list<std::uint8_t>, прежнее представление
+// unrolled_list<bool>) против битовой специализации unrolled_list<bool>:
+// байты на флаг, подсчёт единиц, поиск единственной единицы в конце
+// списка и вставки в середину.
+
+constexpr std::size_t node_size = 512;
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* container, const char* name, double seconds) {
+    std::cout << container << " " << name << ": " << seconds * 1e3 << " ms" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+    unrolled_list<std::uint8_t, node_size> bytes;
+    unrolled_list<bool, node_size> bits;
+    for (std::size_t i = 0; i < count; ++i) {
+        bool flag = i + 1 == count;
+        bytes.push_back(flag);
+        bits.push_back(flag);
+    }
+    std::cout << "bytes per flag: uint8_t " << static_cast<double>(bytes.stats().bytes_allocated) / static_cast<double>(count)
+              << ", bool " << static_cast<double>(bits.bytes_allocated()) / static_cast<double>(count) << std::endl;
+
+    std::size_t ones_bytes = 0;
+    std::size_t ones_bits = 0;
+    report("uint8_t", "count", measure([&] {
+        ones_bytes = static_cast<std::size_t>(std::count(bytes.begin(), bytes.end(), 1));
+    }));
+    report("bool", "count", measure([&] {
+        ones_bits = bits.count();
+    }));
+
+    std::size_t found_bytes = 0;
+    std::size_t found_bits = 0;
+    report("uint8_t", "find first set", measure([&] {
+        found_bytes = static_cast<std::size_t>(std::distance(bytes.begin(), std::find(bytes.begin(), bytes.end(), 1)));
+    }));
+    report("bool", "find first set", measure([&] {
+        found_bits = bits.find_first();
+    }));
+
+    std::size_t inserts = 100'000;
+    report("uint8_t", "insert in the middle", measure([&] {
+        auto it = std::next(bytes.begin(), static_cast<std::ptrdiff_t>(count / 2));
+        for (std::size_t i = 0; i < inserts; ++i) {
+            it = bytes.insert(it, 1);
+        }
+    }));
+    report("bool", "insert in the middle", measure([&] {
+        auto it = std::next(bits.begin(), static_cast<std::ptrdiff_t>(count / 2));
+        for (std::size_t i = 0; i < inserts; ++i) {
+            it = bits.insert(it, true);
+        }
+    }));
+    return ones_bytes == ones_bits && found_bytes == found_bits ? 0 : 1;
+}
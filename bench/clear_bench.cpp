@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "unrolled_list.h"
+
+// clear() большого списка тривиально разрушаемых элементов: без пула узлы
+// по одному возвращаются аллокатору, с Policy::node_pool вся цепочка
+// переходит в пул одной перевязкой. Для пула отдельно замеряется повторное
+// заполнение из пула против заполнения с выделением узлов.
+
+constexpr std::size_t node_size = 64;
+
+struct pooled_policy : unrolled_list_policy {
+    static constexpr bool node_pool = true;
+};
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* container, const char* name, double seconds) {
+    std::cout << container << " " << name << ": " << seconds * 1e3 << " ms" << std::endl;
+}
+
+template<typename List>
+void fill(List& list, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+}
+
+template<typename List>
+void run(const char* container, std::size_t count) {
+    List list;
+    report(container, "fill", measure([&] { fill(list, count); }));
+    report(container, "clear", measure([&] { list.clear(); }));
+    report(container, "refill", measure([&] { fill(list, count); }));
+    report(container, "destroy", measure([&] { List gone(std::move(list)); }));
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+    run<unrolled_list<std::uint64_t, node_size>>("plain", count);
+    run<unrolled_list<std::uint64_t, node_size, std::allocator<std::uint64_t>, pooled_policy>>("pooled", count);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "unrolled_deque.h"
+
+// unrolled_deque против std::deque: добавление в конец, обход,
+// случайный доступ по индексу, lower_bound и очередь «в конец — из начала».
+// Второй аргумент (unrolled64, unrolled512, std) запускает один контейнер.
+// Перед замерами контейнер один раз заполняется и уничтожается, чтобы
+// push_back не платил за первое касание страниц кучи.
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* container, const char* name, std::size_t ops, double seconds) {
+    std::cout << container << " " << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(ops) / seconds / 1e6 << " Mops/s" << std::endl;
+}
+
+template<typename Container>
+void run(const char* name, std::size_t count, const std::vector<std::size_t>& probes) {
+    {
+        Container warm;
+        for (std::size_t i = 0; i < count; ++i) {
+            warm.push_back(i);
+        }
+    }
+    Container c;
+    report(name, "push_back", count, measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            c.push_back(i * 2);
+        }
+    }));
+
+    std::uint64_t sum = 0;
+    report(name, "iterate", count, measure([&] {
+        sum += std::accumulate(c.begin(), c.end(), std::uint64_t{0});
+    }));
+    report(name, "operator[]", probes.size(), measure([&] {
+        for (std::size_t i : probes) {
+            sum += c[i];
+        }
+    }));
+    report(name, "lower_bound", probes.size(), measure([&] {
+        for (std::size_t i : probes) {
+            sum += *std::lower_bound(c.begin(), c.end(), i);
+        }
+    }));
+    report(name, "queue", count, measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            c.push_back(i);
+            sum += c.front();
+            c.pop_front();
+        }
+    }));
+    if (sum == 42) std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::mt19937_64 rng(1);
+    std::vector<std::size_t> probes(1'000'000);
+    for (std::size_t& p : probes) {
+        p = rng() % count;
+    }
+    std::string which = argc > 2 ? argv[2] : "all";
+    if (which == "all" || which == "unrolled64") {
+        run<unrolled_deque<std::uint64_t, 64>>("unrolled_deque<64>", count, probes);
+    }
+    if (which == "all" || which == "unrolled512") {
+        run<unrolled_deque<std::uint64_t, 512>>("unrolled_deque<512>", count, probes);
+    }
+    if (which == "all" || which == "std") {
+        run<std::deque<std::uint64_t>>("std::deque", count, probes);
+    }
+    return 0;
+}
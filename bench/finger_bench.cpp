@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "unrolled_list.h"
+
+// Обращения по номеру тремя шаблонами: подряд, «k, k + 1, k + 3» с редкими
+// прыжками и равномерно случайно. operator[] с пальцем сравнивается
+// с обходом по узлам от ближайшего конца (константный operator[] списка,
+// у которого палец ни разу не запоминался) и с std::next(begin(), k).
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* pattern, const char* how, std::size_t ops, double seconds) {
+    std::cout << pattern << ", " << how << ": " << seconds * 1e9 / static_cast<double>(ops) << " ns/lookup" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    std::size_t probes_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20'000;
+    unrolled_list<std::uint64_t, 64> list;
+    for (std::size_t i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    const unrolled_list<std::uint64_t, 64> no_finger = list;
+
+    std::mt19937_64 rng(3);
+    std::vector<std::size_t> sequential(probes_count);
+    std::vector<std::size_t> local(probes_count);
+    std::vector<std::size_t> uniform(probes_count);
+    std::size_t k = count / 3;
+    for (std::size_t i = 0; i < probes_count; ++i) {
+        sequential[i] = (count / 2 + i) % count;
+        k = rng() % 1000 == 0 ? rng() % count : (k + rng() % 4) % count;
+        local[i] = k;
+        uniform[i] = rng() % count;
+    }
+
+    std::uint64_t sum = 0;
+    for (auto [pattern, probes] : {std::pair{"sequential", &sequential}, std::pair{"local", &local}, std::pair{"uniform", &uniform}}) {
+        report(pattern, "std::next from head", probes->size(), measure([&] {
+            for (std::size_t p : *probes) {
+                sum += *std::next(list.begin(), static_cast<std::ptrdiff_t>(p));
+            }
+        }));
+        report(pattern, "nodes from nearest end", probes->size(), measure([&] {
+            for (std::size_t p : *probes) {
+                sum += no_finger[p];
+            }
+        }));
+        report(pattern, "operator[] with finger", probes->size(), measure([&] {
+            for (std::size_t p : *probes) {
+                sum += list[p];
+            }
+        }));
+    }
+    return sum == 42 ? 1 : 0;
+}
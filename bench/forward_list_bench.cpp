@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <forward_list>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "unrolled_list.h"
+#include "unrolled_forward_list.h"
+
+// Нагрузка «дописать и пройти вперёд»: push_back, сумма по обходу
+// и вставка после каждого десятого элемента у unrolled_forward_list,
+// unrolled_list и std::forward_list. Второй аргумент (forward, list, std)
+// запускает один контейнер; перед замерами контейнер один раз
+// заполняется и уничтожается, чтобы не платить за первое касание кучи.
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* container, const char* name, std::size_t ops, double seconds) {
+    std::cout << container << " " << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(ops) / seconds / 1e6 << " Mops/s" << std::endl;
+}
+
+// У std::forward_list нет push_back: дописываем после запомненного хвоста.
+struct std_forward_list {
+    std::forward_list<std::uint32_t> list;
+    std::forward_list<std::uint32_t>::iterator last = list.before_begin();
+
+    void push_back(std::uint32_t val) {
+        last = list.insert_after(last, val);
+    }
+    auto begin() const { return list.begin(); }
+    auto end() const { return list.end(); }
+};
+
+template<typename Container, typename InsertAfter>
+void run(const char* name, std::size_t count, InsertAfter insert_after) {
+    {
+        Container warm;
+        for (std::size_t i = 0; i < count; ++i) {
+            warm.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    Container c;
+    report(name, "push_back", count, measure([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            c.push_back(static_cast<std::uint32_t>(i));
+        }
+    }));
+
+    std::uint64_t sum = 0;
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        best = std::min(best, measure([&] {
+            sum += std::accumulate(c.begin(), c.end(), std::uint64_t{0});
+        }));
+    }
+    report(name, "scan", count, best);
+
+    std::size_t inserted = count / 10;
+    report(name, "insert every 10th", inserted, measure([&] {
+        insert_after(c, inserted);
+    }));
+    if (sum == 42) std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::string which = argc > 2 ? argv[2] : "all";
+    if (which == "all" || which == "forward") {
+        run<unrolled_forward_list<std::uint32_t, 64>>("unrolled_forward_list<64>", count, [](auto& c, std::size_t n) {
+            auto it = c.begin();
+            for (std::size_t i = 0; i < n; ++i) {
+                std::advance(it, 9);
+                it = c.insert_after(it, 0);
+                ++it;
+            }
+        });
+    }
+    if (which == "all" || which == "list") {
+        run<unrolled_list<std::uint32_t, 64>>("unrolled_list<64>", count, [](auto& c, std::size_t n) {
+            auto it = c.begin();
+            for (std::size_t i = 0; i < n; ++i) {
+                std::advance(it, 10);
+                it = c.insert(it, 0);
+                ++it;
+            }
+        });
+    }
+    if (which == "all" || which == "std") {
+        run<std_forward_list>("std::forward_list", count, [](auto& c, std::size_t n) {
+            auto it = c.list.begin();
+            for (std::size_t i = 0; i < n; ++i) {
+                std::advance(it, 9);
+                it = c.list.insert_after(it, 0);
+                ++it;
+            }
+        });
+    }
+    return 0;
+}
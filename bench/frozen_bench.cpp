@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#include "unrolled_list.h"
+#include "frozen_unrolled_list.h"
+
+// Память и скорость суммирования для двух типичных рядов целых:
+// монотонных меток времени и малых идентификаторов. Сравниваются
+// unrolled_list, несжатый frozen_unrolled_list и он же после freeze().
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t count, std::size_t bytes, double seconds) {
+    std::cout << name << ": " << static_cast<double>(bytes) / static_cast<double>(count) << " bytes/element, "
+              << static_cast<double>(count) / seconds / 1e6 << " M elements/s" << std::endl;
+}
+
+template<typename List>
+double best_block_sum(const List& list, std::uint64_t& sum) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        best = std::min(best, measure([&] {
+            sum = 0;
+            list.for_each_block([&](std::span<const std::uint64_t> block) {
+                sum = std::accumulate(block.begin(), block.end(), sum);
+            });
+        }));
+    }
+    return best;
+}
+
+template<typename List>
+double best_iterator_sum(const List& list, std::uint64_t& sum) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        best = std::min(best, measure([&] {
+            sum = std::accumulate(list.begin(), list.end(), std::uint64_t{0});
+        }));
+    }
+    return best;
+}
+
+template<typename Gen>
+bool run(const char* series, std::size_t count, Gen gen) {
+    constexpr std::size_t node_size = 256;
+    unrolled_list<std::uint64_t, node_size> plain;
+    frozen_unrolled_list<std::uint64_t, node_size> packed;
+    for (std::size_t i = 0; i < count; ++i) {
+        plain.push_back(gen(i));
+        packed.push_back(gen(i));
+    }
+    std::cout << series << std::endl;
+
+    std::uint64_t expected = 0;
+    std::uint64_t sum = 0;
+    report("  unrolled_list, iterator", count, plain.stats().bytes_allocated, best_iterator_sum(plain, expected));
+    report("  frozen_unrolled_list, plain nodes, blocks", count, packed.memory_usage(), best_block_sum(packed, sum));
+    bool ok = sum == expected;
+    packed.freeze();
+    report("  frozen_unrolled_list, frozen, blocks", count, packed.memory_usage(), best_block_sum(packed, sum));
+    ok = ok && sum == expected;
+    report("  frozen_unrolled_list, frozen, iterator", count, packed.memory_usage(), best_iterator_sum(packed, sum));
+    return ok && sum == expected;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    bool ok = run("timestamps", count, [](std::size_t i) {
+        return std::uint64_t{1'700'000'000'000'000} + i * 1000 + (i * 2654435761u) % 1000;
+    });
+    ok = run("small ids", count, [](std::size_t i) {
+        return std::uint64_t{40'000'000} + (i * 2654435761u) % 4096;
+    }) && ok;
+    return ok ? 0 : 1;
+}
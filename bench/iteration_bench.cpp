@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "unrolled_list.h"
+
+// Поэлементный обход: unrolled_list с разными размерами узла против
+// std::deque и std::vector. Берётся лучший из нескольких проходов.
+
+template<typename Container>
+void run(const char* name, std::size_t count) {
+    Container c;
+    for (std::size_t i = 0; i < count; ++i) {
+        c.push_back(i);
+    }
+
+    std::uint64_t sum = 0;
+    double best = 1e9;
+    std::size_t reps = std::max<std::size_t>(7, 200'000'000 / count);
+    for (std::size_t rep = 0; rep < reps; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        sum += std::accumulate(c.begin(), c.end(), std::uint64_t{0});
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    std::cout << name << ": " << best * 1e3 << " ms, "
+              << static_cast<double>(count) / best / 1e6 << " M elements/s"
+              << (sum == 42 ? " " : "") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    run<unrolled_list<std::uint64_t, 16>>("unrolled_list<16>", count);
+    run<unrolled_list<std::uint64_t, 64>>("unrolled_list<64>", count);
+    run<unrolled_list<std::uint64_t, 256>>("unrolled_list<256>", count);
+    run<std::deque<std::uint64_t>>("std::deque", count);
+    run<std::vector<std::uint64_t>>("std::vector", count);
+    return 0;
+}
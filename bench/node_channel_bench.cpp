@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "unrolled_list.h"
+#include "node_channel.h"
+
+// Двухстадийный конвейер: первая стадия порождает значения, вторая их
+// сворачивает; обе делают немного работы на элемент. Сравниваются
+// «сначала заполнить unrolled_list, потом обработать» и node_channel,
+// где вторая стадия получает узлы по мере заполнения. Печатаются время
+// и пиковый объём данных в узлах.
+
+constexpr std::size_t node_size = 256;
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t count, double seconds, std::size_t peak_bytes) {
+    std::cout << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(count) / seconds / 1e6 << " M elements/s, peak "
+              << static_cast<double>(peak_bytes) / (1 << 20) << " MiB in nodes" << std::endl;
+}
+
+std::uint64_t produce(std::uint64_t i) {
+    std::uint64_t x = i * 0x9E3779B97F4A7C15ull;
+    for (int k = 0; k < 8; ++k) {
+        x ^= x >> 29;
+        x *= 0xBF58476D1CE4E5B9ull;
+    }
+    return x;
+}
+
+std::uint64_t consume(std::uint64_t acc, std::uint64_t x) {
+    for (int k = 0; k < 8; ++k) {
+        x ^= x >> 31;
+        x *= 0x94D049BB133111EBull;
+    }
+    return acc + x;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::size_t in_flight = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+
+    std::uint64_t sequential = 0;
+    std::size_t list_bytes = 0;
+    double list_time = measure([&] {
+        unrolled_list<std::uint64_t, node_size> list;
+        for (std::size_t i = 0; i < count; ++i) {
+            list.push_back(produce(i));
+        }
+        list_bytes = list.stats().bytes_allocated;
+        for (std::uint64_t x : list) {
+            sequential = consume(sequential, x);
+        }
+    });
+    report("unrolled_list, fill then consume", count, list_time, list_bytes);
+
+    std::uint64_t streamed = 0;
+    node_channel<std::uint64_t, node_size> ch(in_flight);
+    double channel_time = measure([&] {
+        std::thread producer([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                ch.push(produce(i));
+            }
+            ch.close();
+        });
+        for (auto&& batch : ch.batches()) {
+            for (std::uint64_t x : batch) {
+                streamed = consume(streamed, x);
+            }
+        }
+        producer.join();
+    });
+    report("node_channel, streamed", count, channel_time, ch.nodes_allocated() * node_size * sizeof(std::uint64_t));
+    return sequential == streamed ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#include "unrolled_list.h"
+
+// Байты на элемент по stats() и скорость обхода для нескольких форм узла
+// с обычными ссылками и со ссылками через xor.
+
+struct xor_policy : unrolled_list_policy {
+    static constexpr bool xor_links = true;
+};
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template<typename List>
+void report(const char* name, std::size_t count) {
+    using value_type = typename List::value_type;
+    List list;
+    for (std::size_t i = 0; i < count; ++i) {
+        list.push_back(static_cast<value_type>(i));
+    }
+    auto st = list.stats();
+    std::uint64_t sum = 0;
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        best = std::min(best, measure([&] {
+            sum = std::accumulate(list.begin(), list.end(), std::uint64_t{0});
+        }));
+    }
+    std::cout << name << ": " << static_cast<double>(st.bytes_allocated) / static_cast<double>(st.elements)
+              << " bytes/element (" << st.bytes_allocated / st.nodes << " per node), "
+              << static_cast<double>(count) / best / 1e6 << " M elements/s"
+              << (sum == 0 && count > 1 ? " !" : "") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    report<unrolled_list<int, 10>>("unrolled_list<int, 10>", count);
+    report<unrolled_list<int, 10, std::allocator<int>, xor_policy>>("unrolled_list<int, 10>, xor_links", count);
+    report<unrolled_list<char, 7>>("unrolled_list<char, 7>", count);
+    report<unrolled_list<char, 7, std::allocator<char>, xor_policy>>("unrolled_list<char, 7>, xor_links", count);
+    report<unrolled_list<std::uint16_t, 4>>("unrolled_list<uint16_t, 4>", count);
+    report<unrolled_list<std::uint16_t, 4, std::allocator<std::uint16_t>, xor_policy>>("unrolled_list<uint16_t, 4>, xor_links", count);
+    report<unrolled_list<int, 64>>("unrolled_list<int, 64>", count);
+    report<unrolled_list<int, 64, std::allocator<int>, xor_policy>>("unrolled_list<int, 64>, xor_links", count);
+    return 0;
+}
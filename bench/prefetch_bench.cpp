@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "unrolled_list.h"
+
+// Полный обход списка, узлы которого намеренно разбросаны по памяти:
+// без подгрузки, с подгрузкой следующего узла и двух следующих.
+
+// Раздаёт узлы из одной большой области в случайном порядке, так что
+// соседние в списке узлы оказываются далеко друг от друга.
+struct scattered_arena {
+    std::vector<std::byte>   memory;
+    std::vector<std::size_t> order;
+    std::size_t              slot_size = 0;
+    std::size_t              next      = 0;
+
+    static scattered_arena& instance() {
+        static scattered_arena arena;
+        return arena;
+    }
+
+    void* take(std::size_t bytes) {
+        if (slot_size == 0) {
+            slot_size = (bytes + 63) / 64 * 64;
+            std::shuffle(order.begin(), order.end(), std::mt19937(1));
+            memory.resize(order.size() * slot_size + 64);
+        }
+        if (bytes > slot_size || next == order.size()) throw std::bad_alloc();
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(memory.data());
+        std::uintptr_t aligned = (base + 63) / 64 * 64;
+        return reinterpret_cast<void*>(aligned + order[next++] * slot_size);
+    }
+    void reset(std::size_t slots) {
+        order.resize(slots);
+        std::iota(order.begin(), order.end(), 0);
+        memory.clear();
+        slot_size = 0;
+        next = 0;
+    }
+};
+
+template<typename T>
+struct scattered_allocator {
+    using value_type = T;
+
+    scattered_allocator() = default;
+    template<typename U>
+    scattered_allocator(const scattered_allocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(scattered_arena::instance().take(n * sizeof(T)));
+    }
+    void deallocate(T*, std::size_t) {}
+
+    bool operator==(const scattered_allocator&) const {
+        return true;
+    }
+};
+
+template<std::size_t Distance>
+struct prefetch_policy : unrolled_list_policy {
+    static constexpr std::size_t prefetch_distance = Distance;
+};
+
+template<std::size_t N, std::size_t Distance>
+void run(std::size_t count) {
+    scattered_arena::instance().reset(count / N + 1);
+    unrolled_list<std::uint64_t, N, scattered_allocator<std::uint64_t>, prefetch_policy<Distance>> list;
+    for (std::size_t i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+
+    std::uint64_t sum = 0;
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t v : list) {
+            sum += v;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    std::cout << "node " << N << ", prefetch distance " << Distance << ": "
+              << best * 1e3 << " ms, " << static_cast<double>(count) / best / 1e6 << " M elements/s"
+              << (sum == 42 ? " " : "") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+    run<4, 0>(count);
+    run<4, 1>(count);
+    run<4, 2>(count);
+    run<16, 0>(count);
+    run<16, 1>(count);
+    run<16, 2>(count);
+    run<64, 0>(count);
+    run<64, 1>(count);
+    run<64, 2>(count);
+    return 0;
+}
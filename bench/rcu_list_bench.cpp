@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "unrolled_list.h"
+#include "rcu_unrolled_list.h"
+
+// Пропускная способность читателей, которые непрерывно обходят список,
+// пока один писатель дописывает и изредка удаляет элементы:
+// rcu_unrolled_list против unrolled_list под std::shared_mutex.
+
+constexpr std::size_t initial_size = 100'000;
+constexpr auto run_time = std::chrono::milliseconds(500);
+
+template<typename Reader, typename Writer>
+double run(std::size_t reader_count, Reader reader, Writer writer) {
+    std::atomic<bool> done = false;
+    std::atomic<std::size_t> passes = 0;
+    std::vector<std::thread> threads;
+    for (std::size_t r = 0; r < reader_count; ++r) {
+        threads.emplace_back([&] {
+            std::size_t local = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                reader();
+                ++local;
+            }
+            passes += local;
+        });
+    }
+    std::thread writer_thread([&] {
+        unsigned step = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            writer(step++);
+        }
+    });
+    std::this_thread::sleep_for(run_time);
+    done = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+    writer_thread.join();
+    return static_cast<double>(passes.load()) / std::chrono::duration<double>(run_time).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_readers = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    if (max_readers == 0) max_readers = 1;
+
+    std::cout << "readers\trcu passes/s\tshared_mutex passes/s" << std::endl;
+    for (std::size_t readers = 1; readers <= max_readers; readers *= 2) {
+        rcu_unrolled_list<long long, 64> rcu;
+        for (std::size_t i = 0; i < initial_size; ++i) {
+            rcu.push_back(static_cast<long long>(i));
+        }
+        std::atomic<long long> sink = 0;
+        double rcu_rate = run(readers,
+            [&] {
+                auto guard = rcu.read_lock();
+                long long sum = 0;
+                for (long long x : guard) sum += x;
+                sink += sum;
+            },
+            [&](unsigned step) {
+                rcu.push_back(step);
+                if (step % 16 == 0) rcu.erase(step % rcu.size());
+                if (step % 1024 == 0) rcu.reclaim();
+            });
+
+        unrolled_list<long long, 64> locked;
+        std::shared_mutex mutex;
+        for (std::size_t i = 0; i < initial_size; ++i) {
+            locked.push_back(static_cast<long long>(i));
+        }
+        double locked_rate = run(readers,
+            [&] {
+                std::shared_lock lock(mutex);
+                long long sum = 0;
+                for (long long x : locked) sum += x;
+                sink += sum;
+            },
+            [&](unsigned step) {
+                std::unique_lock lock(mutex);
+                locked.push_back(step);
+                if (step % 16 == 0) locked.pop_front();
+            });
+
+        std::cout << readers << '\t' << rcu_rate << '\t' << locked_rate << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "unrolled_list.h"
+
+// Запись и чтение списка целиком: поэлементно через поток против
+// serialize/deserialize, которые пишут каждый узел одним блоком.
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t bytes, double seconds) {
+    std::cout << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(bytes) / seconds / (1 << 20) << " MiB/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    using list_type = unrolled_list<std::uint64_t, 256>;
+    list_type list;
+    for (std::size_t i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    std::size_t bytes = count * sizeof(std::uint64_t);
+
+    std::vector<std::byte> per_element;
+    report("write per element", bytes, measure([&] {
+        per_element.reserve(bytes);
+        for (std::uint64_t v : list) {
+            const std::byte* p = reinterpret_cast<const std::byte*>(&v);
+            per_element.insert(per_element.end(), p, p + sizeof(v));
+        }
+    }));
+
+    std::vector<std::byte> buffer;
+    report("serialize to buffer", bytes, measure([&] {
+        buffer.reserve(bytes + 64);
+        list.serialize(buffer);
+    }));
+
+    list_type restored;
+    report("deserialize from buffer", bytes, measure([&] { restored.deserialize(buffer); }));
+    if (restored != list) return 1;
+
+    std::stringstream stream;
+    report("serialize to stream", bytes, measure([&] { list.serialize(stream); }));
+    report("deserialize from stream", bytes, measure([&] { restored.deserialize(stream); }));
+    if (restored != list) return 1;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "unrolled_list.h"
+#include "sharded_appender.h"
+
+// Несколько потоков дописывают count элементов в один список:
+// unrolled_list под std::mutex против sharded_appender с collect() в конце.
+// Время sharded_appender включает collect().
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t threads, std::size_t count, double seconds) {
+    std::cout << name << ", " << threads << " threads: " << seconds * 1e3 << " ms, "
+              << static_cast<double>(count) / seconds / 1e6 << " M elements/s" << std::endl;
+}
+
+template<typename Fn>
+void run_threads(std::size_t threads, Fn fn) {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(fn, t);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+    {
+        unrolled_list<std::uint64_t, 64> warm;
+        for (std::size_t i = 0; i < count; ++i) {
+            warm.push_back(i);
+        }
+    }
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::size_t per_thread = count / threads;
+
+        unrolled_list<std::uint64_t, 64> shared;
+        std::mutex mutex;
+        report("mutex + push_back", threads, per_thread * threads, measure([&] {
+            run_threads(threads, [&](std::size_t t) {
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    std::lock_guard lock(mutex);
+                    shared.push_back(t * per_thread + i);
+                }
+            });
+        }));
+
+        sharded_appender<std::uint64_t, 64> out(threads);
+        unrolled_list<std::uint64_t, 64> collected;
+        report("sharded_appender", threads, per_thread * threads, measure([&] {
+            run_threads(threads, [&](std::size_t t) {
+                auto& shard = out.shard(t);
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    shard.push_back(t * per_thread + i);
+                }
+            });
+            collected = out.collect();
+        }));
+        if (collected.size() != shared.size()) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#include "unrolled_list.h"
+#include "soa_unrolled_list.h"
+
+// Сумма одного поля по списку структур: unrolled_list<order> читает
+// элементы целиком, soa_unrolled_list — только столбец price.
+
+struct order {
+    std::uint64_t id;
+    double        price;
+    std::uint32_t qty;
+};
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t count, double seconds) {
+    std::cout << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(count) / seconds / 1e6 << " M elements/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    unrolled_list<order, 256> aos;
+    soa_unrolled_list<order, 256, &order::id, &order::price, &order::qty> soa;
+    for (std::size_t i = 0; i < count; ++i) {
+        order o{i, 0.25 * static_cast<double>(i % 1000), static_cast<std::uint32_t>(i % 7)};
+        aos.push_back(o);
+        soa.push_back(o);
+    }
+
+    double aos_sum = 0;
+    double soa_sum = 0;
+    double best_aos = 1e9;
+    double best_soa = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        best_aos = std::min(best_aos, measure([&] {
+            aos_sum = 0;
+            for (const order& o : aos) {
+                aos_sum += o.price;
+            }
+        }));
+        best_soa = std::min(best_soa, measure([&] {
+            soa_sum = 0;
+            soa.for_each_segment<&order::price>([&](std::span<const double> prices) {
+                soa_sum = std::accumulate(prices.begin(), prices.end(), soa_sum);
+            });
+        }));
+    }
+    report("unrolled_list<order> price sum", count, best_aos);
+    report("soa_unrolled_list price column sum", count, best_soa);
+    return aos_sum == soa_sum ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "unrolled_list.h"
+#include "spsc_unrolled_queue.h"
+
+// Передача N чисел из потока-производителя в поток-потребитель:
+// spsc_unrolled_queue (поштучно и пачками) против unrolled_list под мьютексом.
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t count, double seconds) {
+    std::cout << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(count) / seconds / 1e6 << " Mops/s" << std::endl;
+}
+
+long long run_spsc(std::size_t count) {
+    spsc_unrolled_queue<int, 64> queue;
+    long long sum = 0;
+    std::thread producer([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            queue.push(static_cast<int>(i));
+        }
+    });
+    std::size_t received = 0;
+    int value = 0;
+    while (received < count) {
+        if (queue.try_pop(value)) {
+            sum += value;
+            ++received;
+        }
+    }
+    producer.join();
+    return sum;
+}
+
+long long run_spsc_batched(std::size_t count) {
+    constexpr std::size_t batch = 32;
+    spsc_unrolled_queue<int, 64> queue;
+    long long sum = 0;
+    std::thread producer([&] {
+        int buffer[batch];
+        for (std::size_t i = 0; i < count; i += batch) {
+            std::size_t n = std::min(batch, count - i);
+            for (std::size_t j = 0; j < n; ++j) {
+                buffer[j] = static_cast<int>(i + j);
+            }
+            queue.push_n(buffer, n);
+        }
+    });
+    std::size_t received = 0;
+    int buffer[batch];
+    while (received < count) {
+        std::size_t n = queue.try_pop_n(buffer, batch);
+        for (std::size_t j = 0; j < n; ++j) {
+            sum += buffer[j];
+        }
+        received += n;
+    }
+    producer.join();
+    return sum;
+}
+
+long long run_mutex_list(std::size_t count) {
+    unrolled_list<int, 64> list;
+    std::mutex mutex;
+    long long sum = 0;
+    std::thread producer([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::lock_guard lock(mutex);
+            list.push_back(static_cast<int>(i));
+        }
+    });
+    std::size_t received = 0;
+    while (received < count) {
+        std::lock_guard lock(mutex);
+        if (!list.empty()) {
+            sum += list.front();
+            list.pop_front();
+            ++received;
+        }
+    }
+    producer.join();
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    long long expected = static_cast<long long>(count) * static_cast<long long>(count - 1) / 2;
+    long long sum = 0;
+
+    report("spsc_unrolled_queue push/try_pop", count, measure([&] { sum = run_spsc(count); }));
+    if (sum != expected) return 1;
+    report("spsc_unrolled_queue push_n/try_pop_n", count, measure([&] { sum = run_spsc_batched(count); }));
+    if (sum != expected) return 1;
+    report("unrolled_list + std::mutex", count, measure([&] { sum = run_mutex_list(count); }));
+    if (sum != expected) return 1;
+    return 0;
+}
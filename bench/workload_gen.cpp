@@ -0,0 +1,296 @@
+#include <array>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "unrolled_list.h"
+#include "bin/trace.h"
+
+// Генератор синтетической нагрузки: прогоняет смесь операций на unrolled_list
+// и печатает пропускную способность, пиковый RSS и статистику узлов.
+//
+//     workload_gen --mix=append --ops=1000000 --size=100000 --node=64 --type=u64 --seed=1
+//
+// --mix — имя готовой смеси (append, window, middle, scan) или список весов
+// вида push_back=90,erase=10 с операциями из bin/trace.h. --emit=<file>
+// дополнительно пишет сгенерированные операции в формате трассы, чтобы
+// воспроизвести их программой unrolled_list replay; payload в ней — длина
+// строки для --type=string и sizeof(T) для остальных типов.
+
+namespace {
+
+struct record32 {
+    std::uint64_t fields[4];
+};
+
+struct options {
+    std::string mix   = "append";
+    std::size_t ops   = 1'000'000;
+    std::size_t size  = 100'000;
+    std::size_t node  = 64;
+    std::string type  = "u64";
+    unsigned    seed  = 1;
+    std::string emit;
+};
+
+const std::map<std::string, std::string> presets = {
+    {"append", "push_back=90,erase=10"},
+    {"window", "push_back=50,pop_front=50"},
+    {"middle", "insert=70,erase=30"},
+    {"scan",   "iterate=1,push_back=50,pop_front=49"},
+};
+
+double parse_weight(const std::string& text) {
+    char* end = nullptr;
+    double w = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !std::isfinite(w) || w < 0) {
+        throw std::runtime_error("bad weight in mix: " + text);
+    }
+    return w;
+}
+
+std::array<double, trace_op_count> parse_mix(std::string mix) {
+    if (auto it = presets.find(mix); it != presets.end()) {
+        mix = it->second;
+    }
+    std::array<double, trace_op_count> weights{};
+    std::istringstream items(mix);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        std::size_t eq = item.find('=');
+        std::string name = item.substr(0, eq);
+        bool known = false;
+        for (std::size_t k = 0; k < trace_op_count; ++k) {
+            if (name == trace_op_name(static_cast<trace_op>(k))) {
+                weights[k] = eq == std::string::npos ? 1.0 : parse_weight(item.substr(eq + 1));
+                known = true;
+            }
+        }
+        if (!known) {
+            throw std::runtime_error("unknown operation in mix: " + name);
+        }
+    }
+    double total = 0;
+    for (double w : weights) {
+        total += w;
+    }
+    if (!(total > 0) || !std::isfinite(total)) {
+        throw std::runtime_error("mix has no positive weights: " + mix);
+    }
+    return weights;
+}
+
+template<typename T>
+T make_value(std::uint64_t seed) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(8 + seed % 24, 'x');
+    } else if constexpr (std::is_same_v<T, record32>) {
+        return record32{{seed, seed + 1, seed + 2, seed + 3}};
+    } else {
+        return static_cast<T>(seed);
+    }
+}
+
+template<typename T>
+std::uint64_t weight_of(const T& val) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return val.size();
+    } else if constexpr (std::is_same_v<T, record32>) {
+        return val.fields[0];
+    } else {
+        return static_cast<std::uint64_t>(val);
+    }
+}
+
+struct generated_op {
+    trace_op      op;
+    std::uint64_t random;
+};
+
+template<typename T, std::size_t N>
+void run(const options& opt, const std::vector<generated_op>& plan, std::ostream* emit) {
+    unrolled_list<T, N> list;
+    // Трасса копится в памяти и пишется после замера, чтобы вывод
+    // в --emit не попадал в измеренное время.
+    std::vector<trace_entry> trace;
+    if (emit) trace.reserve(opt.size + plan.size());
+    for (std::size_t i = 0; i < opt.size; ++i) {
+        T val = make_value<T>(i);
+        if (emit) trace.push_back({trace_op::push_back, 0, trace_payload(val)});
+        list.push_back(std::move(val));
+    }
+
+    std::uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const generated_op& g : plan) {
+        std::size_t size = list.size();
+        trace_op op = g.op;
+        if (size == 0 && (op == trace_op::pop_back || op == trace_op::pop_front || op == trace_op::erase)) {
+            op = trace_op::push_back;
+        }
+        switch (op) {
+        case trace_op::push_back: {
+            T val = make_value<T>(g.random);
+            if (emit) trace.push_back({op, 0, trace_payload(val)});
+            list.push_back(std::move(val));
+            break;
+        }
+        case trace_op::push_front: {
+            T val = make_value<T>(g.random);
+            if (emit) trace.push_back({op, 0, trace_payload(val)});
+            list.push_front(std::move(val));
+            break;
+        }
+        case trace_op::pop_back:
+            list.pop_back();
+            if (emit) trace.push_back({op});
+            break;
+        case trace_op::pop_front:
+            list.pop_front();
+            if (emit) trace.push_back({op});
+            break;
+        case trace_op::insert: {
+            std::size_t pos = g.random % (size + 1);
+            T val = make_value<T>(g.random);
+            if (emit) trace.push_back({op, pos, trace_payload(val)});
+            list.insert(std::next(list.begin(), static_cast<std::ptrdiff_t>(pos)), std::move(val));
+            break;
+        }
+        case trace_op::erase: {
+            std::size_t pos = g.random % size;
+            list.erase(std::next(list.begin(), static_cast<std::ptrdiff_t>(pos)));
+            if (emit) trace.push_back({op, pos});
+            break;
+        }
+        case trace_op::iterate:
+            for (const T& val : list) {
+                checksum += weight_of(val);
+            }
+            if (emit) trace.push_back({op});
+            break;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    for (const trace_entry& entry : trace) {
+        write_trace_entry(*emit, entry);
+    }
+
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    auto st = list.stats();
+
+    std::cout << "mix " << opt.mix << ", type " << opt.type << ", node " << N << ", seed " << opt.seed << '\n'
+              << "ops: " << plan.size() << " in " << elapsed.count() * 1e3 << " ms, "
+              << static_cast<double>(plan.size()) / elapsed.count() / 1e6 << " Mops/s\n"
+              << "peak rss: " << usage.ru_maxrss / 1024 << " MiB\n"
+              << "elements: " << st.elements << ", nodes: " << st.nodes
+              << ", fill min/avg/max: " << st.min_fill << '/' << st.avg_fill << '/' << st.max_fill << '\n'
+              << "bytes allocated/used: " << st.bytes_allocated << '/' << st.bytes_used << '\n'
+              << "checksum: " << checksum << std::endl;
+}
+
+template<typename T, std::size_t N, std::size_t... Rest>
+bool dispatch_node(const options& opt, const std::vector<generated_op>& plan, std::ostream* emit) {
+    if (opt.node == N) {
+        run<T, N>(opt, plan, emit);
+        return true;
+    }
+    if constexpr (sizeof...(Rest) > 0) {
+        return dispatch_node<T, Rest...>(opt, plan, emit);
+    }
+    return false;
+}
+
+template<typename T>
+bool dispatch(const options& opt, const std::vector<generated_op>& plan, std::ostream* emit) {
+    return dispatch_node<T, 8, 16, 32, 64, 128, 256>(opt, plan, emit);
+}
+
+std::size_t parse_count(const std::string& key, const std::string& text) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long n = std::strtoull(text.c_str(), &end, 10);
+    if (text.empty() || text[0] == '-' || *end != '\0' || errno == ERANGE) {
+        throw std::runtime_error("bad value for --" + key + ": " + text);
+    }
+    return static_cast<std::size_t>(n);
+}
+
+options parse_options(int argc, char** argv) {
+    options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            throw std::runtime_error("expected --key=value, got " + arg);
+        }
+        std::string key = arg.substr(2, eq - 2);
+        std::string value = arg.substr(eq + 1);
+        if (key == "mix") opt.mix = value;
+        else if (key == "ops") opt.ops = parse_count(key, value);
+        else if (key == "size") opt.size = parse_count(key, value);
+        else if (key == "node") opt.node = parse_count(key, value);
+        else if (key == "type") opt.type = value;
+        else if (key == "seed") opt.seed = static_cast<unsigned>(parse_count(key, value));
+        else if (key == "emit") opt.emit = value;
+        else throw std::runtime_error("unknown option --" + key);
+    }
+    return opt;
+}
+
+}
+
+int main(int argc, char** argv) {
+    options opt;
+    std::array<double, trace_op_count> weights;
+    try {
+        opt = parse_options(argc, argv);
+        weights = parse_mix(opt.mix);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\nmixes: append, window, middle, scan or op=weight,..."
+                  << "\ntypes: i32, u64, record32, string; node: 8..256 (power of two)" << std::endl;
+        return 2;
+    }
+
+    std::mt19937_64 rng(opt.seed);
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::vector<generated_op> plan(opt.ops);
+    for (generated_op& g : plan) {
+        g.op = static_cast<trace_op>(pick(rng));
+        g.random = rng();
+    }
+
+    std::ofstream emit_file;
+    std::ostream* emit = nullptr;
+    if (!opt.emit.empty()) {
+        emit_file.open(opt.emit);
+        if (!emit_file.is_open()) {
+            std::cerr << "cannot open " << opt.emit << std::endl;
+            return 1;
+        }
+        emit_file << "# workload_gen --mix=" << opt.mix << " --seed=" << opt.seed << '\n';
+        emit = &emit_file;
+    }
+
+    bool ok = opt.type == "i32"      ? dispatch<std::int32_t>(opt, plan, emit)
+            : opt.type == "u64"      ? dispatch<std::uint64_t>(opt, plan, emit)
+            : opt.type == "record32" ? dispatch<record32>(opt, plan, emit)
+            : opt.type == "string"   ? dispatch<std::string>(opt, plan, emit)
+            : false;
+    if (!ok) {
+        std::cerr << "unsupported type/node combination: " << opt.type << '/' << opt.node << std::endl;
+        return 2;
+    }
+    return 0;
+}
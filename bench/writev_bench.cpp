@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <unistd.h>
+
+#include "unrolled_list.h"
+
+// Запись списка в файл: копирование в промежуточный буфер и write
+// против write_fd, который отдаёт storage узлов в writev без копирования.
+
+template<typename F>
+double measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t bytes, double seconds) {
+    std::cout << name << ": " << seconds * 1e3 << " ms, "
+              << static_cast<double>(bytes) / seconds / (1 << 20) << " MiB/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    unrolled_list<std::uint64_t, 512> list;
+    for (std::size_t i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    std::size_t bytes = count * sizeof(std::uint64_t);
+
+    std::FILE* file = std::tmpfile();
+    if (!file) return 1;
+    int fd = ::fileno(file);
+
+    std::vector<std::byte> staging;
+    report("copy + write", bytes, measure([&] {
+        staging.clear();
+        staging.reserve(bytes);
+        list.for_each_segment([&](std::span<const std::byte> seg) {
+            staging.insert(staging.end(), seg.begin(), seg.end());
+        });
+        const std::byte* p = staging.data();
+        std::size_t left = staging.size();
+        while (left > 0) {
+            ssize_t written = ::write(fd, p, left);
+            if (written <= 0) std::exit(1);
+            p += written;
+            left -= static_cast<std::size_t>(written);
+        }
+    }));
+
+    if (::ftruncate(fd, 0) != 0 || ::lseek(fd, 0, SEEK_SET) != 0) return 1;
+    std::size_t written = 0;
+    report("write_fd (writev)", bytes, measure([&] { written = list.write_fd(fd); }));
+
+    std::fclose(file);
+    return written == bytes ? 0 : 1;
+}
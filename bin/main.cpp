@@ -1,32 +1,223 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "unrolled_list.h"
+#include "trace.h"
+
+// Запись и воспроизведение трасс операций (формат описан в trace.h).
+//
+//     unrolled_list record <trace> [ops] [seed]
+//         пишет синтетическую трассу через trace_recorder;
+//     unrolled_list replay <trace> [container...]
+//         воспроизводит трассу на каждом контейнере и печатает перцентили
+//         задержки по видам операций. Контейнеры: unrolled:N (N — размер
+//         узла, степень двойки от 4 до 256), vector, deque, list.
 
-int main() {
-    // Создаём объект unrolled_list с максимальным размером узла 5
-    unrolled_list<int, 5> ul;
+namespace {
 
-    // Добавляем элементы с помощью push_back и push_front.
-    for (int i = 1; i <= 10; ++i) {
-        ul.push_back(i);
+struct latencies {
+    std::vector<std::uint64_t> ns[trace_op_count];
+};
+
+template<typename Container>
+void apply(Container& c, const trace_entry& entry, std::string&& payload, std::size_t& checksum) {
+    std::size_t size = c.size();
+    switch (entry.op) {
+    case trace_op::push_back:
+        c.push_back(std::move(payload));
+        break;
+    case trace_op::push_front:
+        if constexpr (requires { c.push_front(std::move(payload)); }) {
+            c.push_front(std::move(payload));
+        } else {
+            c.insert(c.begin(), std::move(payload));
+        }
+        break;
+    case trace_op::pop_back:
+        if (size > 0) c.pop_back();
+        break;
+    case trace_op::pop_front:
+        if (size == 0) break;
+        if constexpr (requires { c.pop_front(); }) {
+            c.pop_front();
+        } else {
+            c.erase(c.begin());
+        }
+        break;
+    case trace_op::insert:
+        c.insert(std::next(c.begin(), static_cast<std::ptrdiff_t>(std::min<std::uint64_t>(entry.pos, size))),
+                 std::move(payload));
+        break;
+    case trace_op::erase:
+        if (size == 0) break;
+        c.erase(std::next(c.begin(), static_cast<std::ptrdiff_t>(std::min<std::uint64_t>(entry.pos, size - 1))));
+        break;
+    case trace_op::iterate:
+        for (const std::string& s : c) {
+            checksum += s.size();
+        }
+        break;
     }
-    ul.push_front(0);
+}
 
-    // Выводим содержимое контейнера.
-    std::cout << "Elements in unrolled_list:" << std::endl;
-    for (auto it = ul.begin(); it != ul.end(); ++it) {
-        std::cout << *it << " ";
+template<typename Container>
+latencies replay(const std::vector<trace_entry>& trace, std::size_t& checksum) {
+    latencies result;
+    Container c;
+    for (const trace_entry& entry : trace) {
+        std::string payload(entry.payload, 'x');
+        auto start = std::chrono::steady_clock::now();
+        apply(c, entry, std::move(payload), checksum);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        result.ns[static_cast<std::size_t>(entry.op)].push_back(
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
     }
-    std::cout << std::endl;
+    return result;
+}
 
-    // Проверяем pop_back и pop_front.
-    ul.pop_back();   // Удаляем последний элемент.
-    ul.pop_front();  // Удаляем первый элемент.
+template<std::size_t N>
+bool replay_unrolled(std::size_t node_size, const std::vector<trace_entry>& trace, latencies& out, std::size_t& checksum) {
+    if (node_size != N) return false;
+    out = replay<unrolled_list<std::string, N>>(trace, checksum);
+    return true;
+}
 
-    std::cout << "After pop_back and pop_front:" << std::endl;
-    for (auto it = ul.begin(); it != ul.end(); ++it) {
-        std::cout << *it << " ";
+bool run(const std::string& name, const std::vector<trace_entry>& trace, latencies& out, std::size_t& checksum) {
+    if (name == "vector") {
+        out = replay<std::vector<std::string>>(trace, checksum);
+    } else if (name == "deque") {
+        out = replay<std::deque<std::string>>(trace, checksum);
+    } else if (name == "list") {
+        out = replay<std::list<std::string>>(trace, checksum);
+    } else if (name.rfind("unrolled:", 0) == 0) {
+        std::size_t n = std::strtoull(name.c_str() + 9, nullptr, 10);
+        return replay_unrolled<4>(n, trace, out, checksum)
+            || replay_unrolled<8>(n, trace, out, checksum)
+            || replay_unrolled<16>(n, trace, out, checksum)
+            || replay_unrolled<32>(n, trace, out, checksum)
+            || replay_unrolled<64>(n, trace, out, checksum)
+            || replay_unrolled<128>(n, trace, out, checksum)
+            || replay_unrolled<256>(n, trace, out, checksum);
+    } else {
+        return false;
     }
-    std::cout << std::endl;
+    return true;
+}
 
+std::uint64_t percentile(const std::vector<std::uint64_t>& sorted, double q) {
+    std::size_t idx = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+void print(const std::string& name, latencies& lat) {
+    std::uint64_t total = 0;
+    for (std::size_t k = 0; k < trace_op_count; ++k) {
+        std::vector<std::uint64_t>& v = lat.ns[k];
+        if (v.empty()) continue;
+        std::sort(v.begin(), v.end());
+        for (std::uint64_t ns : v) total += ns;
+        std::cout << std::left << std::setw(14) << name << std::setw(12) << trace_op_name(static_cast<trace_op>(k))
+                  << std::right << std::setw(10) << v.size()
+                  << std::setw(10) << percentile(v, 0.5)
+                  << std::setw(10) << percentile(v, 0.9)
+                  << std::setw(10) << percentile(v, 0.99)
+                  << std::setw(10) << percentile(v, 0.999)
+                  << std::setw(12) << v.back() << std::endl;
+    }
+    std::cout << std::left << std::setw(14) << name << "total " << total / 1000 << " us" << std::endl;
+}
+
+int record(const std::string& path, std::size_t ops, unsigned seed) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "cannot open " << path << std::endl;
+        return 1;
+    }
+    out << "# synthetic trace: " << ops << " operations, seed " << seed << '\n';
+
+    std::mt19937_64 rng(seed);
+    std::discrete_distribution<int> pick({40, 15, 10, 15, 9, 9, 2});
+    std::uniform_int_distribution<std::uint32_t> payload(4, 48);
+    trace_recorder<std::deque<std::string>> list(out);
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < ops; ++i) {
+        trace_op op = static_cast<trace_op>(pick(rng));
+        if (list.empty() && op != trace_op::push_back && op != trace_op::push_front && op != trace_op::insert) {
+            op = trace_op::push_back;
+        }
+        switch (op) {
+        case trace_op::push_back:  list.push_back(std::string(payload(rng), 'x')); break;
+        case trace_op::push_front: list.push_front(std::string(payload(rng), 'x')); break;
+        case trace_op::pop_back:   list.pop_back(); break;
+        case trace_op::pop_front:  list.pop_front(); break;
+        case trace_op::insert:     list.insert(rng() % (list.size() + 1), std::string(payload(rng), 'x')); break;
+        case trace_op::erase:      list.erase(rng() % list.size()); break;
+        case trace_op::iterate:    list.for_each([&](const std::string& s) { checksum += s.size(); }); break;
+        }
+    }
+    return out ? 0 : 1;
+}
+
+int usage() {
+    std::cerr << "usage: unrolled_list record <trace> [ops] [seed]\n"
+                 "       unrolled_list replay <trace> [unrolled:N|vector|deque|list ...]" << std::endl;
+    return 2;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage();
+    std::string mode = argv[1];
+    std::string path = argv[2];
+
+    if (mode == "record") {
+        std::size_t ops = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100'000;
+        unsigned seed = argc > 4 ? static_cast<unsigned>(std::strtoul(argv[4], nullptr, 10)) : 1;
+        return record(path, ops, seed);
+    }
+    if (mode != "replay") return usage();
+
+    std::vector<trace_entry> trace;
+    try {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "cannot open " << path << std::endl;
+            return 1;
+        }
+        trace = read_trace(in);
+    } catch (const std::exception& e) {
+        std::cerr << path << ": " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> names(argv + 3, argv + argc);
+    if (names.empty()) {
+        names = {"unrolled:16", "unrolled:64", "vector", "deque", "list"};
+    }
+
+    std::cout << std::left << std::setw(14) << "container" << std::setw(12) << "op" << std::right
+              << std::setw(10) << "count" << std::setw(10) << "p50 ns" << std::setw(10) << "p90 ns"
+              << std::setw(10) << "p99 ns" << std::setw(10) << "p99.9 ns" << std::setw(12) << "max ns" << std::endl;
+    std::size_t checksum = 0;
+    for (const std::string& name : names) {
+        latencies lat;
+        if (!run(name, trace, lat, checksum)) {
+            std::cerr << "unknown container " << name << std::endl;
+            return 2;
+        }
+        print(name, lat);
+    }
+    // Печатается, чтобы обходы iterate не выбросил оптимизатор.
+    std::cout << "checksum: " << checksum << std::endl;
     return 0;
 }
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Трасса операций над последовательностью: по одной операции в строке
+//
+//     push_back <payload>
+//     push_front <payload>
+//     pop_back
+//     pop_front
+//     insert <pos> <payload>
+//     erase <pos>
+//     iterate
+//
+// payload — длина строки-элемента в байтах, pos — индекс в контейнере на
+// момент операции. Пустые строки и строки с '#' в начале пропускаются.
+// Для нагрузки на элементах не строкового типа payload — sizeof(T):
+// replay воспроизводит их строками того же размера.
+
+enum class trace_op {
+    push_back,
+    push_front,
+    pop_back,
+    pop_front,
+    insert,
+    erase,
+    iterate,
+};
+
+inline constexpr std::size_t trace_op_count = 7;
+
+inline const char* trace_op_name(trace_op op) {
+    static const char* names[trace_op_count] = {
+        "push_back", "push_front", "pop_back", "pop_front", "insert", "erase", "iterate",
+    };
+    return names[static_cast<std::size_t>(op)];
+}
+
+struct trace_entry {
+    trace_op      op;
+    std::uint64_t pos     = 0;
+    std::uint32_t payload = 0;
+};
+
+// payload для элемента val: длина строки или sizeof(T) для других типов.
+template<typename T>
+std::uint32_t trace_payload(const T& val) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        return static_cast<std::uint32_t>(std::string_view(val).size());
+    } else {
+        return sizeof(T);
+    }
+}
+
+// Пишет операцию одной строкой в формате, который читает read_trace.
+inline void write_trace_entry(std::ostream& os, const trace_entry& entry) {
+    os << trace_op_name(entry.op);
+    if (entry.op == trace_op::insert || entry.op == trace_op::erase) {
+        os << ' ' << entry.pos;
+    }
+    if (entry.op == trace_op::push_back || entry.op == trace_op::push_front || entry.op == trace_op::insert) {
+        os << ' ' << entry.payload;
+    }
+    os << '\n';
+}
+
+inline std::vector<trace_entry> read_trace(std::istream& is) {
+    std::vector<trace_entry> trace;
+    std::string line;
+    for (std::size_t line_no = 1; std::getline(is, line); ++line_no) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name;
+        fields >> name;
+        trace_entry entry{};
+        bool known = false;
+        for (std::size_t k = 0; k < trace_op_count; ++k) {
+            if (name == trace_op_name(static_cast<trace_op>(k))) {
+                entry.op = static_cast<trace_op>(k);
+                known = true;
+            }
+        }
+        if (!known) {
+            throw std::runtime_error("line " + std::to_string(line_no) + ": unknown operation '" + name + "'");
+        }
+        if (entry.op == trace_op::insert || entry.op == trace_op::erase) {
+            fields >> entry.pos;
+        }
+        if (entry.op == trace_op::push_back || entry.op == trace_op::push_front || entry.op == trace_op::insert) {
+            fields >> entry.payload;
+        }
+        if (!fields) {
+            throw std::runtime_error("line " + std::to_string(line_no) + ": missing argument");
+        }
+        trace.push_back(entry);
+    }
+    return trace;
+}
+
+// Обёртка над контейнером строк, которая пишет каждую операцию в трассу.
+// Подставляется вместо контейнера там, где нужно снять профиль нагрузки.
+template<typename Container>
+class trace_recorder {
+public:
+    using value_type = typename Container::value_type;
+
+    explicit trace_recorder(std::ostream& out)
+        : out(out)
+    {}
+
+    void push_back(value_type val) {
+        write_trace_entry(out, {trace_op::push_back, 0, trace_payload(val)});
+        items.push_back(std::move(val));
+    }
+    void push_front(value_type val) {
+        write_trace_entry(out, {trace_op::push_front, 0, trace_payload(val)});
+        items.push_front(std::move(val));
+    }
+    void pop_back() {
+        write_trace_entry(out, {trace_op::pop_back});
+        items.pop_back();
+    }
+    void pop_front() {
+        write_trace_entry(out, {trace_op::pop_front});
+        items.pop_front();
+    }
+    void insert(std::size_t pos, value_type val) {
+        write_trace_entry(out, {trace_op::insert, pos, trace_payload(val)});
+        items.insert(std::next(items.begin(), static_cast<std::ptrdiff_t>(pos)), std::move(val));
+    }
+    void erase(std::size_t pos) {
+        write_trace_entry(out, {trace_op::erase, pos});
+        items.erase(std::next(items.begin(), static_cast<std::ptrdiff_t>(pos)));
+    }
+    template<typename Fn>
+    void for_each(Fn fn) {
+        write_trace_entry(out, {trace_op::iterate});
+        for (const value_type& val : items) {
+            fn(val);
+        }
+    }
+
+    std::size_t size() const {
+        return items.size();
+    }
+    bool empty() const {
+        return items.empty();
+    }
+    const Container& container() const {
+        return items;
+    }
+
+private:
+    std::ostream& out;
+    Container     items;
+};
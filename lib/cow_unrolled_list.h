@@ -0,0 +1,453 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+// Блочный список с дешёвыми неизменяемыми снимками.
+// Узлы хранятся по указателям в общем "хребте" и разделяются между списком
+// и его снимками по счётчику ссылок. snapshot() стоит O(1): снимок просто
+// разделяет хребет. Первое изменение после снимка копирует хребет (указатели,
+// а не элементы), а каждый изменяемый узел клонируется только если он ещё
+// кому-то принадлежит, поэтому цена снимка — O(затронутых узлов).
+template<typename T, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+class cow_unrolled_list {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+private:
+    struct node_struct {
+        std::atomic<std::size_t> refs;
+        std::size_t count;
+        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+        node_struct() : refs(1), count(0) {}
+
+        T* get_ptr(std::size_t i) {
+            return reinterpret_cast<T*>(storage + i * sizeof(T));
+        }
+        const T* get_ptr(std::size_t i) const {
+            return reinterpret_cast<const T*>(storage + i * sizeof(T));
+        }
+        template<typename... Args>
+        void construct_elem(std::size_t idx, Args&&... args) {
+            new (static_cast<void*>(get_ptr(idx))) T(std::forward<Args>(args)...);
+        }
+        void destroy_elem(std::size_t idx) noexcept {
+            get_ptr(idx)->~T();
+        }
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+
+    struct spine_struct {
+        node_alloc_type           node_alloc;
+        std::vector<node_struct*> nodes;
+        size_type                 size;
+
+        explicit spine_struct(const node_alloc_type& alloc) : node_alloc(alloc), size(0) {}
+        spine_struct(const spine_struct& other)
+            : node_alloc(other.node_alloc), nodes(other.nodes), size(other.size)
+        {
+            for (node_struct* n : nodes) {
+                n->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        ~spine_struct() {
+            for (node_struct* n : nodes) {
+                release_node(n);
+            }
+        }
+
+        node_struct* allocate_node() {
+            node_struct* raw_mem = node_alloc.allocate(1);
+            return new (static_cast<void*>(raw_mem)) node_struct();
+        }
+        void free_node(node_struct* nd) noexcept {
+            for (std::size_t i = 0; i < nd->count; ++i) {
+                nd->destroy_elem(i);
+            }
+            nd->~node_struct();
+            node_alloc.deallocate(nd, 1);
+        }
+        void release_node(node_struct* nd) noexcept {
+            if (nd->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                free_node(nd);
+            }
+        }
+    };
+
+public:
+    class const_iterator {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        const spine_struct* spine;
+        std::size_t         node_index;
+        std::size_t         index;
+
+        const_iterator(const spine_struct* s = nullptr, std::size_t n = 0, std::size_t i = 0)
+            : spine(s), node_index(n), index(i)
+        {}
+
+        reference operator*() const {
+            return *(spine->nodes[node_index]->get_ptr(index));
+        }
+        pointer operator->() const {
+            return spine->nodes[node_index]->get_ptr(index);
+        }
+
+        const_iterator& operator++() {
+            if (++index == spine->nodes[node_index]->count) {
+                ++node_index;
+                index = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+        const_iterator& operator--() {
+            if (index == 0) {
+                --node_index;
+                index = spine->nodes[node_index]->count;
+            }
+            --index;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return (node_index == other.node_index) && (index == other.index);
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    using iterator = const_iterator;
+
+    // Неизменяемая версия списка на момент вызова snapshot().
+    class snapshot_type {
+    public:
+        using value_type      = T;
+        using const_reference = const T&;
+        using size_type       = std::size_t;
+        using const_iterator  = typename cow_unrolled_list::const_iterator;
+
+        snapshot_type() = default;
+
+        size_type size() const noexcept {
+            return spine ? spine->size : 0;
+        }
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+        const_reference operator[](size_type pos) const {
+            return cow_unrolled_list::element(*spine, pos);
+        }
+        const_iterator begin() const noexcept {
+            return const_iterator(spine.get(), 0, 0);
+        }
+        const_iterator end() const noexcept {
+            return const_iterator(spine.get(), spine ? spine->nodes.size() : 0, 0);
+        }
+
+    private:
+        friend class cow_unrolled_list;
+
+        explicit snapshot_type(std::shared_ptr<const spine_struct> s) : spine(std::move(s)) {}
+
+        std::shared_ptr<const spine_struct> spine;
+    };
+
+    cow_unrolled_list()
+        : cow_unrolled_list(allocator_type())
+    {}
+    explicit cow_unrolled_list(const allocator_type& alloc)
+        : val_alloc(alloc), spine(std::make_shared<spine_struct>(node_alloc_type(alloc)))
+    {}
+    cow_unrolled_list(std::initializer_list<T> il, const allocator_type& alloc = allocator_type())
+        : cow_unrolled_list(alloc)
+    {
+        for (auto& elem : il) {
+            push_back(elem);
+        }
+    }
+
+    // Восстановление из снимка тоже O(1): хребет разделяется до первого изменения.
+    explicit cow_unrolled_list(const snapshot_type& snap, const allocator_type& alloc = allocator_type())
+        : val_alloc(alloc),
+          spine(snap.spine ? std::const_pointer_cast<spine_struct>(snap.spine)
+                           : std::make_shared<spine_struct>(node_alloc_type(alloc)))
+    {}
+
+    cow_unrolled_list(const cow_unrolled_list& other)
+        : val_alloc(other.val_alloc), spine(other.spine)
+    {}
+    cow_unrolled_list(cow_unrolled_list&& other) noexcept
+        : val_alloc(std::move(other.val_alloc)), spine(std::move(other.spine))
+    {
+        other.spine = nullptr;
+    }
+
+    cow_unrolled_list& operator=(const cow_unrolled_list& other) {
+        spine = other.spine;
+        return *this;
+    }
+    cow_unrolled_list& operator=(cow_unrolled_list&& other) noexcept {
+        if (this != &other) {
+            spine = std::move(other.spine);
+            other.spine = nullptr;
+        }
+        return *this;
+    }
+
+    snapshot_type snapshot() const {
+        return snapshot_type(spine);
+    }
+
+    allocator_type get_allocator() const {
+        return val_alloc;
+    }
+
+    size_type size() const noexcept {
+        return spine ? spine->size : 0;
+    }
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(spine.get(), 0, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(spine.get(), spine ? spine->nodes.size() : 0, 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    const_reference operator[](size_type pos) const {
+        return element(*spine, pos);
+    }
+    const_reference at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range("cow_unrolled_list::at");
+        }
+        return element(*spine, pos);
+    }
+
+    const_reference front() const {
+        return *(spine->nodes.front()->get_ptr(0));
+    }
+    const_reference back() const {
+        node_struct* n = spine->nodes.back();
+        return *(n->get_ptr(n->count - 1));
+    }
+
+    void set(size_type pos, const T& val) {
+        auto [n, idx] = locate(pos);
+        node_struct* nd = own_node(n);
+        *(nd->get_ptr(idx)) = val;
+    }
+
+    void push_back(const T& val) {
+        insert(size(), val);
+    }
+    void push_front(const T& val) {
+        insert(0, val);
+    }
+    void pop_back() {
+        if (!empty()) erase(size() - 1);
+    }
+    void pop_front() {
+        if (!empty()) erase(0);
+    }
+
+    void insert(size_type pos, const T& val) {
+        spine_struct& s = own_spine();
+        if (s.nodes.empty() || (pos == s.size && s.nodes.back()->count == NodeMaxSize)) {
+            s.nodes.reserve(s.nodes.size() + 1);
+            node_struct* nd = s.allocate_node();
+            try {
+                nd->construct_elem(0, val);
+            } catch (...) {
+                s.free_node(nd);
+                throw;
+            }
+            nd->count = 1;
+            s.nodes.push_back(nd);
+            ++s.size;
+            return;
+        }
+        std::size_t n;
+        std::size_t idx;
+        if (pos == s.size) {
+            n = s.nodes.size() - 1;
+            idx = s.nodes[n]->count;
+        } else {
+            std::tie(n, idx) = locate(pos);
+        }
+        node_struct* nd = own_node(n);
+        if (nd->count == NodeMaxSize) {
+            // val может ссылаться на элемент, который уйдёт в новый узел.
+            T tmp(val);
+            s.nodes.reserve(s.nodes.size() + 1);
+            node_struct* right = s.allocate_node();
+            std::size_t half = NodeMaxSize / 2;
+            std::size_t moved = 0;
+            try {
+                for (std::size_t i = half; i < nd->count; ++i, ++moved) {
+                    right->construct_elem(moved, std::move(*nd->get_ptr(i)));
+                    right->count = moved + 1;
+                }
+            } catch (...) {
+                s.free_node(right);
+                throw;
+            }
+            for (std::size_t i = half; i < nd->count; ++i) {
+                nd->destroy_elem(i);
+            }
+            nd->count = half;
+            s.nodes.insert(s.nodes.begin() + n + 1, right);
+            if (idx > half) {
+                nd = right;
+                idx -= half;
+            }
+            insert_into(nd, idx, std::move(tmp));
+        } else {
+            insert_into(nd, idx, val);
+        }
+        ++s.size;
+    }
+
+    void erase(size_type pos) {
+        auto [n, idx] = locate(pos);
+        node_struct* nd = own_node(n);
+        spine_struct& s = *spine;
+        if (nd->count == 1) {
+            s.nodes.erase(s.nodes.begin() + n);
+            s.release_node(nd);
+        } else {
+            for (std::size_t i = idx; i + 1 < nd->count; ++i) {
+                *nd->get_ptr(i) = std::move(*nd->get_ptr(i + 1));
+            }
+            nd->destroy_elem(--nd->count);
+        }
+        --s.size;
+    }
+
+    void clear() {
+        spine = std::make_shared<spine_struct>(node_alloc_type(val_alloc));
+    }
+
+    // Сколько узлов сейчас разделяется со снимками или копиями.
+    size_type shared_node_count() const noexcept {
+        if (!spine) return 0;
+        if (spine.use_count() > 1) return spine->nodes.size();
+        size_type shared = 0;
+        for (node_struct* n : spine->nodes) {
+            if (n->refs.load(std::memory_order_acquire) > 1) ++shared;
+        }
+        return shared;
+    }
+
+    bool operator==(const cow_unrolled_list& rhs) const {
+        return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const cow_unrolled_list& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    allocator_type                val_alloc;
+    std::shared_ptr<spine_struct> spine;
+
+    static const T& element(const spine_struct& s, size_type pos) {
+        for (node_struct* n : s.nodes) {
+            if (pos < n->count) return *(n->get_ptr(pos));
+            pos -= n->count;
+        }
+        throw std::out_of_range("cow_unrolled_list: position out of range");
+    }
+
+    std::pair<std::size_t, std::size_t> locate(size_type pos) const {
+        const auto& nodes = spine->nodes;
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            if (pos < nodes[n]->count) return {n, pos};
+            pos -= nodes[n]->count;
+        }
+        throw std::out_of_range("cow_unrolled_list: position out of range");
+    }
+
+    spine_struct& own_spine() {
+        if (!spine) {
+            spine = std::make_shared<spine_struct>(node_alloc_type(val_alloc));
+        } else if (spine.use_count() > 1) {
+            spine = std::make_shared<spine_struct>(*spine);
+        }
+        return *spine;
+    }
+
+    // Узел, который можно менять на месте: если он разделён, подменяется копией.
+    node_struct* own_node(std::size_t n) {
+        spine_struct& s = own_spine();
+        node_struct* nd = s.nodes[n];
+        if (nd->refs.load(std::memory_order_acquire) == 1) return nd;
+        node_struct* copy = s.allocate_node();
+        try {
+            for (std::size_t i = 0; i < nd->count; ++i) {
+                copy->construct_elem(i, *nd->get_ptr(i));
+                copy->count = i + 1;
+            }
+        } catch (...) {
+            s.free_node(copy);
+            throw;
+        }
+        s.nodes[n] = copy;
+        s.release_node(nd);
+        return copy;
+    }
+
+    template<typename U>
+    void insert_into(node_struct* nd, std::size_t idx, U&& val) {
+        if (idx == nd->count) {
+            nd->construct_elem(idx, std::forward<U>(val));
+        } else {
+            T tmp(std::forward<U>(val));
+            nd->construct_elem(nd->count, std::move(*nd->get_ptr(nd->count - 1)));
+            for (std::size_t i = nd->count - 1; i > idx; --i) {
+                *nd->get_ptr(i) = std::move(*nd->get_ptr(i - 1));
+            }
+            *nd->get_ptr(idx) = std::move(tmp);
+        }
+        ++nd->count;
+    }
+};
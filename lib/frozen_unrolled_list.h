@@ -0,0 +1,534 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Блочный список целых, узлы которого можно «заморозить» — перекодировать
+// в упакованный по битам вид. Используется одна из двух схем:
+//   - frame of reference: минимум узла и смещения от него по width бит;
+//   - delta: для неубывающих узлов первое значение и разности соседних.
+// Выбирается схема с меньшей шириной. Чтение замороженного узла распаковывает
+// значения на лету: итератор — по одному, for_each_block — узел целиком.
+// Изменение узла сначала размораживает его. freeze() замораживает все полные
+// узлы; с AutoFreeze = true узел замораживается сам, как только push_back
+// уходит из него в новый хвостовой узел.
+template<typename T, std::size_t NodeMaxSize = 128, bool AutoFreeze = false, typename Allocator = std::allocator<T>>
+class frozen_unrolled_list {
+    static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "frozen_unrolled_list stores integers up to 64 bits");
+    static_assert(NodeMaxSize > 0, "NodeMaxSize must be positive");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+private:
+    using word_type = std::uint64_t;
+
+    enum class encoding : std::uint8_t {
+        plain,
+        frame,
+        delta,
+    };
+
+    struct node_struct {
+        node_struct* prev   = nullptr;
+        node_struct* next   = nullptr;
+        std::size_t  count  = 0;
+        T*           plain  = nullptr;
+        word_type*   packed = nullptr;
+        std::size_t  words  = 0;
+        word_type    base   = 0;
+        std::uint8_t width  = 0;
+        encoding     enc    = encoding::plain;
+    };
+
+    using node_alloc_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+    using plain_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using word_alloc_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<word_type>;
+
+    node_alloc_type  node_alloc;
+    plain_alloc_type plain_alloc;
+    word_alloc_type  word_alloc;
+    node_struct*     head;
+    node_struct*     tail;
+    size_type        size_;
+
+    // Знаковые значения расширяются знаком, так что разности в 64 битах
+    // у близких отрицательных и положительных чисел остаются малыми.
+    static word_type to_word(T val) noexcept {
+        if constexpr (std::is_signed_v<T>) {
+            return static_cast<word_type>(static_cast<std::int64_t>(val));
+        } else {
+            return static_cast<word_type>(val);
+        }
+    }
+    static T from_word(word_type w) noexcept {
+        return static_cast<T>(w);
+    }
+    static word_type read_bits(const word_type* words, std::size_t pos, unsigned width) noexcept {
+        if (width == 0) return 0;
+        std::size_t w = pos / 64;
+        unsigned shift = static_cast<unsigned>(pos % 64);
+        word_type v = words[w] >> shift;
+        if (shift + width > 64) {
+            v |= words[w + 1] << (64 - shift);
+        }
+        return width == 64 ? v : v & ((word_type{1} << width) - 1);
+    }
+    static void write_bits(word_type* words, std::size_t pos, unsigned width, word_type v) noexcept {
+        if (width == 0) return;
+        std::size_t w = pos / 64;
+        unsigned shift = static_cast<unsigned>(pos % 64);
+        words[w] |= v << shift;
+        if (shift + width > 64) {
+            words[w + 1] |= v >> (64 - shift);
+        }
+    }
+
+    // Значение i-го элемента замороженного узла при известном предыдущем.
+    static word_type decode_next(const node_struct* n, std::size_t i, word_type prev) noexcept {
+        word_type bits = read_bits(n->packed, i * n->width, n->width);
+        if (n->enc == encoding::frame) {
+            return n->base + bits;
+        }
+        return i == 0 ? n->base : prev + bits;
+    }
+    // Произвольный доступ: delta-узел распаковывается с начала.
+    static word_type decode_at(const node_struct* n, std::size_t idx) noexcept {
+        if (n->enc == encoding::plain) {
+            return to_word(n->plain[idx]);
+        }
+        if (n->enc == encoding::frame) {
+            return decode_next(n, idx, 0);
+        }
+        word_type v = 0;
+        for (std::size_t i = 0; i <= idx; ++i) {
+            v = decode_next(n, i, v);
+        }
+        return v;
+    }
+
+public:
+    class const_iterator {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+        using pointer           = const T*;
+        using reference         = T;
+
+        const_iterator(const node_struct* n = nullptr, std::size_t i = 0) noexcept
+            : node_ptr(n), index(i), current(n ? decode_at(n, i) : 0)
+        {}
+
+        T operator*() const noexcept {
+            return from_word(current);
+        }
+
+        // Внутри delta-узла следующее значение строится от текущего.
+        const_iterator& operator++() noexcept {
+            if (++index == node_ptr->count) {
+                node_ptr = node_ptr->next;
+                index = 0;
+                current = node_ptr ? decode_at(node_ptr, 0) : 0;
+            } else if (node_ptr->enc == encoding::plain) {
+                current = to_word(node_ptr->plain[index]);
+            } else {
+                current = decode_next(node_ptr, index, current);
+            }
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept {
+            return node_ptr == other.node_ptr && index == other.index;
+        }
+        bool operator!=(const const_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        const node_struct* node_ptr;
+        std::size_t        index;
+        word_type          current;
+    };
+
+    using iterator = const_iterator;
+
+    frozen_unrolled_list()
+        : frozen_unrolled_list(Allocator())
+    {}
+    explicit frozen_unrolled_list(const Allocator& alloc)
+        : node_alloc(alloc), plain_alloc(alloc), word_alloc(alloc), head(nullptr), tail(nullptr), size_(0)
+    {}
+    frozen_unrolled_list(std::initializer_list<T> il, const Allocator& alloc = Allocator())
+        : frozen_unrolled_list(alloc)
+    {
+        for (T val : il) {
+            push_back(val);
+        }
+    }
+    frozen_unrolled_list(const frozen_unrolled_list& other)
+        : frozen_unrolled_list(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.node_alloc))
+    {
+        for (T val : other) {
+            push_back(val);
+        }
+    }
+    frozen_unrolled_list(frozen_unrolled_list&& other) noexcept
+        : node_alloc(other.node_alloc), plain_alloc(other.plain_alloc), word_alloc(other.word_alloc),
+          head(other.head), tail(other.tail), size_(other.size_)
+    {
+        other.head = other.tail = nullptr;
+        other.size_ = 0;
+    }
+    frozen_unrolled_list& operator=(const frozen_unrolled_list& other) {
+        if (this != &other) {
+            frozen_unrolled_list tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    frozen_unrolled_list& operator=(frozen_unrolled_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+    ~frozen_unrolled_list() {
+        clear();
+    }
+
+    void swap(frozen_unrolled_list& other) noexcept {
+        using std::swap;
+        swap(node_alloc,  other.node_alloc);
+        swap(plain_alloc, other.plain_alloc);
+        swap(word_alloc,  other.word_alloc);
+        swap(head,        other.head);
+        swap(tail,        other.tail);
+        swap(size_,       other.size_);
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr, 0);
+    }
+
+    T front() const noexcept {
+        return *begin();
+    }
+    T back() const noexcept {
+        return from_word(decode_at(tail, tail->count - 1));
+    }
+    T operator[](size_type pos) const noexcept {
+        auto [n, idx] = locate(pos);
+        return from_word(decode_at(n, idx));
+    }
+    T at(size_type pos) const {
+        if (pos >= size_) {
+            throw std::out_of_range("frozen_unrolled_list::at");
+        }
+        return (*this)[pos];
+    }
+
+    // Вызывает fn(std::span<const T>) по узлу за раз; замороженный узел
+    // распаковывается во временный буфер целиком.
+    template<typename Fn>
+    void for_each_block(Fn fn) const {
+        T buffer[NodeMaxSize];
+        for (const node_struct* n = head; n; n = n->next) {
+            if (n->enc == encoding::plain) {
+                fn(std::span<const T>(n->plain, n->count));
+                continue;
+            }
+            word_type v = 0;
+            for (std::size_t i = 0; i < n->count; ++i) {
+                v = decode_next(n, i, v);
+                buffer[i] = from_word(v);
+            }
+            fn(std::span<const T>(buffer, n->count));
+        }
+    }
+
+    void push_back(T val) {
+        if (!tail || tail->count == NodeMaxSize) {
+            node_struct* nd = allocate_node();
+            nd->prev = tail;
+            if (tail) {
+                tail->next = nd;
+            } else {
+                head = nd;
+            }
+            node_struct* cold = tail;
+            tail = nd;
+            if constexpr (AutoFreeze) {
+                if (cold) freeze_node(cold);
+            }
+        }
+        thaw_node(tail);
+        tail->plain[tail->count++] = val;
+        ++size_;
+    }
+    void push_front(T val) {
+        if (!head || head->count == NodeMaxSize) {
+            node_struct* nd = allocate_node();
+            nd->next = head;
+            if (head) {
+                head->prev = nd;
+            } else {
+                tail = nd;
+            }
+            head = nd;
+        }
+        thaw_node(head);
+        std::copy_backward(head->plain, head->plain + head->count, head->plain + head->count + 1);
+        head->plain[0] = val;
+        ++head->count;
+        ++size_;
+    }
+    void pop_back() {
+        if (!tail) return;
+        thaw_node(tail);
+        --size_;
+        if (--tail->count == 0) {
+            unlink(tail);
+        }
+    }
+    void pop_front() {
+        if (!head) return;
+        thaw_node(head);
+        --size_;
+        if (--head->count == 0) {
+            unlink(head);
+        } else {
+            std::copy(head->plain + 1, head->plain + head->count + 1, head->plain);
+        }
+    }
+
+    void insert(size_type pos, T val) {
+        if (pos >= size_) {
+            push_back(val);
+            return;
+        }
+        auto [n, idx] = locate(pos);
+        thaw_node(n);
+        if (n->count == NodeMaxSize) {
+            split(n);
+            if (idx > n->count) {
+                idx -= n->count;
+                n = n->next;
+            }
+        }
+        std::copy_backward(n->plain + idx, n->plain + n->count, n->plain + n->count + 1);
+        n->plain[idx] = val;
+        ++n->count;
+        ++size_;
+    }
+    void erase(size_type pos) {
+        auto [n, idx] = locate(pos);
+        thaw_node(n);
+        std::copy(n->plain + idx + 1, n->plain + n->count, n->plain + idx);
+        --size_;
+        if (--n->count == 0) {
+            unlink(n);
+        }
+    }
+    void set(size_type pos, T val) {
+        auto [n, idx] = locate(pos);
+        thaw_node(n);
+        n->plain[idx] = val;
+    }
+
+    void clear() noexcept {
+        while (head) {
+            node_struct* next = head->next;
+            deallocate_node(head);
+            head = next;
+        }
+        tail = nullptr;
+        size_ = 0;
+    }
+
+    // Замораживает все полные узлы и возвращает число перекодированных.
+    size_type freeze() {
+        size_type frozen = 0;
+        for (node_struct* n = head; n; n = n->next) {
+            if (n->enc == encoding::plain && n->count == NodeMaxSize) {
+                freeze_node(n);
+                frozen += n->enc != encoding::plain;
+            }
+        }
+        return frozen;
+    }
+    void thaw() {
+        for (node_struct* n = head; n; n = n->next) {
+            thaw_node(n);
+        }
+    }
+
+    size_type node_count() const noexcept {
+        size_type nodes = 0;
+        for (const node_struct* n = head; n; n = n->next) {
+            ++nodes;
+        }
+        return nodes;
+    }
+    size_type frozen_node_count() const noexcept {
+        size_type nodes = 0;
+        for (const node_struct* n = head; n; n = n->next) {
+            nodes += n->enc != encoding::plain;
+        }
+        return nodes;
+    }
+    // Байты, занятые узлами: заголовки, несжатые массивы и упакованные слова.
+    size_type memory_usage() const noexcept {
+        size_type bytes = 0;
+        for (const node_struct* n = head; n; n = n->next) {
+            bytes += sizeof(node_struct);
+            bytes += n->plain ? NodeMaxSize * sizeof(T) : n->words * sizeof(word_type);
+        }
+        return bytes;
+    }
+
+private:
+    std::pair<node_struct*, std::size_t> locate(size_type pos) const noexcept {
+        node_struct* n = head;
+        while (pos >= n->count) {
+            pos -= n->count;
+            n = n->next;
+        }
+        return {n, pos};
+    }
+
+    // Выбирает схему с меньшей шириной; если упаковка не меньше исходного
+    // массива, узел остаётся несжатым.
+    void freeze_node(node_struct* n) {
+        if (n->enc != encoding::plain) return;
+        T lo_val = n->plain[0];
+        T hi_val = n->plain[0];
+        bool monotone = true;
+        word_type max_delta = 0;
+        for (std::size_t i = 1; i < n->count; ++i) {
+            lo_val = std::min(lo_val, n->plain[i]);
+            hi_val = std::max(hi_val, n->plain[i]);
+            monotone = monotone && !(n->plain[i] < n->plain[i - 1]);
+            if (monotone) {
+                max_delta = std::max(max_delta, to_word(n->plain[i]) - to_word(n->plain[i - 1]));
+            }
+        }
+        word_type lo = to_word(lo_val);
+        word_type hi = to_word(hi_val);
+        unsigned frame_width = static_cast<unsigned>(std::bit_width(hi - lo));
+        unsigned delta_width = monotone ? static_cast<unsigned>(std::bit_width(max_delta)) : 64;
+        bool use_delta = delta_width < frame_width;
+        unsigned width = use_delta ? delta_width : frame_width;
+
+        std::size_t words = (n->count * width + 63) / 64 + 1;
+        if (words * sizeof(word_type) >= NodeMaxSize * sizeof(T)) return;
+
+        word_type* packed = word_alloc.allocate(words);
+        std::fill(packed, packed + words, word_type{0});
+        for (std::size_t i = 0; i < n->count; ++i) {
+            word_type v = to_word(n->plain[i]);
+            word_type bits = use_delta ? (i == 0 ? 0 : v - to_word(n->plain[i - 1])) : v - lo;
+            write_bits(packed, i * width, width, bits);
+        }
+        n->base = use_delta ? to_word(n->plain[0]) : lo;
+        plain_alloc.deallocate(n->plain, NodeMaxSize);
+        n->plain = nullptr;
+        n->packed = packed;
+        n->words = words;
+        n->width = static_cast<std::uint8_t>(width);
+        n->enc = use_delta ? encoding::delta : encoding::frame;
+    }
+    void thaw_node(node_struct* n) {
+        if (n->enc == encoding::plain) return;
+        T* plain = plain_alloc.allocate(NodeMaxSize);
+        word_type v = 0;
+        for (std::size_t i = 0; i < n->count; ++i) {
+            v = decode_next(n, i, v);
+            plain[i] = from_word(v);
+        }
+        word_alloc.deallocate(n->packed, n->words);
+        n->packed = nullptr;
+        n->words = 0;
+        n->plain = plain;
+        n->enc = encoding::plain;
+    }
+
+    void split(node_struct* n) {
+        node_struct* nd = allocate_node();
+        std::size_t half = n->count / 2;
+        std::copy(n->plain + half, n->plain + n->count, nd->plain);
+        nd->count = n->count - half;
+        n->count = half;
+        nd->prev = n;
+        nd->next = n->next;
+        if (n->next) {
+            n->next->prev = nd;
+        } else {
+            tail = nd;
+        }
+        n->next = nd;
+    }
+    void unlink(node_struct* n) noexcept {
+        if (n->prev) {
+            n->prev->next = n->next;
+        } else {
+            head = n->next;
+        }
+        if (n->next) {
+            n->next->prev = n->prev;
+        } else {
+            tail = n->prev;
+        }
+        deallocate_node(n);
+    }
+
+    node_struct* allocate_node() {
+        node_struct* nd = node_alloc.allocate(1);
+        new (static_cast<void*>(nd)) node_struct();
+        try {
+            nd->plain = plain_alloc.allocate(NodeMaxSize);
+        } catch (...) {
+            node_alloc.deallocate(nd, 1);
+            throw;
+        }
+        return nd;
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        if (nd->plain) {
+            plain_alloc.deallocate(nd->plain, NodeMaxSize);
+        }
+        if (nd->packed) {
+            word_alloc.deallocate(nd->packed, nd->words);
+        }
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
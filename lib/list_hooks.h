@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "unrolled_list.h"
+
+// Готовые хуки для unrolled_list: подключаются через политику
+//
+//     struct traced : unrolled_list_policy {
+//         using hooks = timing_hooks;
+//     };
+//
+// а результаты читаются через list.hooks().
+
+// Считает события и суммарный amount по каждому виду события.
+struct counting_hooks {
+    std::array<std::size_t, unrolled_list_event_count> events{};
+    std::array<std::size_t, unrolled_list_event_count> amounts{};
+
+    void enter(unrolled_list_event) noexcept {}
+    void leave(unrolled_list_event e, std::size_t amount) noexcept {
+        ++events[index(e)];
+        amounts[index(e)] += amount;
+    }
+
+    std::size_t count(unrolled_list_event e) const noexcept {
+        return events[index(e)];
+    }
+    std::size_t amount(unrolled_list_event e) const noexcept {
+        return amounts[index(e)];
+    }
+
+private:
+    static std::size_t index(unrolled_list_event e) noexcept {
+        return static_cast<std::size_t>(e);
+    }
+};
+
+// Для каждого вида события строит гистограмму длительностей:
+// в корзину k попадают события, длившиеся от 2^(k-1) до 2^k - 1 нс.
+struct timing_hooks {
+    static constexpr std::size_t bucket_count = 64;
+
+    using histogram = std::array<std::size_t, bucket_count>;
+
+    std::array<histogram, unrolled_list_event_count> histograms{};
+
+    void enter(unrolled_list_event e) noexcept {
+        started[index(e)] = std::chrono::steady_clock::now();
+    }
+    void leave(unrolled_list_event e, std::size_t) noexcept {
+        auto elapsed = std::chrono::steady_clock::now() - started[index(e)];
+        auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        ++histograms[index(e)][std::min<std::size_t>(std::bit_width(ns), bucket_count - 1)];
+    }
+
+    const histogram& of(unrolled_list_event e) const noexcept {
+        return histograms[index(e)];
+    }
+    std::size_t count(unrolled_list_event e) const noexcept {
+        std::size_t total = 0;
+        for (std::size_t n : histograms[index(e)]) {
+            total += n;
+        }
+        return total;
+    }
+    // Верхняя граница (в нс) корзины, в которую попадает доля q событий.
+    std::uint64_t percentile(unrolled_list_event e, double q) const noexcept {
+        std::size_t total = count(e);
+        std::size_t seen = 0;
+        for (std::size_t k = 0; k < bucket_count; ++k) {
+            seen += histograms[index(e)][k];
+            if (total > 0 && static_cast<double>(seen) >= q * static_cast<double>(total)) {
+                return (std::uint64_t{1} << k) - 1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    std::array<std::chrono::steady_clock::time_point, unrolled_list_event_count> started{};
+
+    static std::size_t index(unrolled_list_event e) noexcept {
+        return static_cast<std::size_t>(e);
+    }
+};
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Блочный список, узлы которого живут в отображённом в память файле.
+// Вместо указателей prev/next узлы ссылаются друг на друга номерами слотов,
+// поэтому файл можно отобразить по любому адресу: открытие — это один mmap
+// без разбора содержимого. Файл состоит из страницы заголовка и сегментов;
+// сегмент — битовая карта занятых слотов и slots_per_segment слотов
+// фиксированного размера. sync() сбрасывает изменения на диск.
+template<typename T, std::size_t NodeMaxSize = 64>
+class mapped_unrolled_list {
+    static_assert(std::is_trivially_copyable_v<T>, "mapped_unrolled_list stores T as raw bytes");
+
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    static constexpr std::uint64_t npos              = ~std::uint64_t{0};
+    static constexpr std::uint32_t format_magic      = 0x4C4D4C55;
+    static constexpr std::uint32_t format_version    = 1;
+    static constexpr std::size_t   header_bytes      = 4096;
+    static constexpr std::size_t   slots_per_segment = 512;
+    static constexpr std::size_t   bitmap_words      = slots_per_segment / 64;
+    static constexpr std::size_t   bitmap_bytes      = 64;
+
+    static_assert(bitmap_words * sizeof(std::uint64_t) <= bitmap_bytes);
+
+    struct file_header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t elem_size;
+        std::uint32_t node_max;
+        std::uint64_t segment_count;
+        std::uint64_t head;
+        std::uint64_t tail;
+        std::uint64_t size;
+        std::uint64_t node_count;
+    };
+
+    struct node_struct {
+        std::uint64_t prev;
+        std::uint64_t next;
+        std::uint64_t count;
+        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+        T* get_ptr(std::size_t i) {
+            return reinterpret_cast<T*>(storage + i * sizeof(T));
+        }
+        const T* get_ptr(std::size_t i) const {
+            return reinterpret_cast<const T*>(storage + i * sizeof(T));
+        }
+    };
+
+    static_assert(alignof(node_struct) <= bitmap_bytes);
+
+    static constexpr std::size_t segment_bytes = bitmap_bytes + slots_per_segment * sizeof(node_struct);
+
+public:
+    template<bool is_const>
+    class iterators_class {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using pointer           = std::conditional_t<is_const, const T*, T*>;
+        using reference         = std::conditional_t<is_const, const T&, T&>;
+        using list_pointer      = std::conditional_t<is_const, const mapped_unrolled_list*, mapped_unrolled_list*>;
+
+        iterators_class(list_pointer l = nullptr, std::uint64_t s = npos, std::size_t i = 0)
+            : list(l), slot(s), index(i)
+        {}
+
+        template<bool B, typename = std::enable_if_t<!B && is_const>>
+        iterators_class(const iterators_class<B>& other)
+            : list(other.list), slot(other.slot), index(other.index)
+        {}
+
+        reference operator*() const {
+            return *(list->node(slot)->get_ptr(index));
+        }
+        pointer operator->() const {
+            return list->node(slot)->get_ptr(index);
+        }
+
+        iterators_class& operator++() {
+            if (++index == list->node(slot)->count) {
+                slot = list->node(slot)->next;
+                index = 0;
+            }
+            return *this;
+        }
+        iterators_class operator++(int) {
+            iterators_class tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+        iterators_class& operator--() {
+            if (slot == npos) {
+                slot = list->header()->tail;
+                index = list->node(slot)->count;
+            } else if (index == 0) {
+                slot = list->node(slot)->prev;
+                index = list->node(slot)->count;
+            }
+            --index;
+            return *this;
+        }
+        iterators_class operator--(int) {
+            iterators_class tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterators_class& other) const {
+            return (slot == other.slot) && (index == other.index);
+        }
+        bool operator!=(const iterators_class& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        template<bool> friend class iterators_class;
+
+        list_pointer  list;
+        std::uint64_t slot;
+        std::size_t   index;
+    };
+
+    using iterator       = iterators_class<false>;
+    using const_iterator = iterators_class<true>;
+
+    // Открывает существующий файл или создаёт новый пустой список.
+    explicit mapped_unrolled_list(const std::string& path)
+        : fd(-1), base(nullptr), mapped_bytes(0), free_hint(0)
+    {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "mapped_unrolled_list: open " + path);
+        }
+        try {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_unrolled_list: fstat");
+            }
+            if (st.st_size == 0) {
+                resize_file(header_bytes);
+                file_header* h = header();
+                h->magic = format_magic;
+                h->version = format_version;
+                h->elem_size = sizeof(T);
+                h->node_max = NodeMaxSize;
+                h->segment_count = 0;
+                h->head = h->tail = npos;
+                h->size = 0;
+                h->node_count = 0;
+            } else {
+                map(static_cast<std::size_t>(st.st_size));
+                const file_header* h = header();
+                if (mapped_bytes < header_bytes || h->magic != format_magic || h->version != format_version) {
+                    throw std::runtime_error("mapped_unrolled_list: " + path + " is not a list file");
+                }
+                if (h->elem_size != sizeof(T) || h->node_max != NodeMaxSize
+                    || h->segment_count > (mapped_bytes - header_bytes) / segment_bytes) {
+                    throw std::runtime_error("mapped_unrolled_list: " + path + " has an incompatible layout");
+                }
+                std::uint64_t slots = h->segment_count * slots_per_segment;
+                bool empty = h->head == npos;
+                if (empty != (h->tail == npos) || (empty && h->size != 0)
+                    || (!empty && (h->head >= slots || h->tail >= slots))) {
+                    throw std::runtime_error("mapped_unrolled_list: " + path + " is corrupt");
+                }
+            }
+        } catch (...) {
+            unmap();
+            ::close(fd);
+            throw;
+        }
+    }
+
+    mapped_unrolled_list(const mapped_unrolled_list&) = delete;
+    mapped_unrolled_list& operator=(const mapped_unrolled_list&) = delete;
+
+    mapped_unrolled_list(mapped_unrolled_list&& other) noexcept
+        : fd(std::exchange(other.fd, -1)),
+          base(std::exchange(other.base, nullptr)),
+          mapped_bytes(std::exchange(other.mapped_bytes, 0)),
+          free_hint(other.free_hint)
+    {}
+    mapped_unrolled_list& operator=(mapped_unrolled_list&& other) noexcept {
+        if (this != &other) {
+            close_file();
+            fd = std::exchange(other.fd, -1);
+            base = std::exchange(other.base, nullptr);
+            mapped_bytes = std::exchange(other.mapped_bytes, 0);
+            free_hint = other.free_hint;
+        }
+        return *this;
+    }
+
+    ~mapped_unrolled_list() {
+        close_file();
+    }
+
+    // Сбрасывает отображение на диск; после возврата содержимое переживает сбой.
+    void sync() {
+        if (::msync(base, mapped_bytes, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "mapped_unrolled_list: msync");
+        }
+    }
+
+    size_type size() const noexcept {
+        return header()->size;
+    }
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+    size_type node_count() const noexcept {
+        return header()->node_count;
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, header()->head, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, header()->head, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, npos, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, npos, 0);
+    }
+
+    T& front() {
+        return *(node(header()->head)->get_ptr(0));
+    }
+    const T& front() const {
+        return *(node(header()->head)->get_ptr(0));
+    }
+    T& back() {
+        node_struct* n = node(header()->tail);
+        return *(n->get_ptr(n->count - 1));
+    }
+    const T& back() const {
+        const node_struct* n = node(header()->tail);
+        return *(n->get_ptr(n->count - 1));
+    }
+
+    void push_back(const T& val) {
+        // val может ссылаться на элемент списка: рост файла снимает старое отображение.
+        T tmp = val;
+        std::uint64_t t = header()->tail;
+        if (t == npos || node(t)->count == NodeMaxSize) {
+            std::uint64_t s = allocate_slot();
+            t = header()->tail;
+            node_struct* nd = node(s);
+            nd->prev = t;
+            nd->next = npos;
+            nd->count = 0;
+            if (t != npos) {
+                node(t)->next = s;
+            } else {
+                header()->head = s;
+            }
+            header()->tail = s;
+            t = s;
+        }
+        node_struct* n = node(t);
+        std::memcpy(n->get_ptr(n->count), &tmp, sizeof(T));
+        ++n->count;
+        ++header()->size;
+    }
+
+    void push_front(const T& val) {
+        // Копия до allocate_slot и сдвига: val может ссылаться на элемент списка.
+        T tmp = val;
+        std::uint64_t h = header()->head;
+        if (h == npos || node(h)->count == NodeMaxSize) {
+            std::uint64_t s = allocate_slot();
+            h = header()->head;
+            node_struct* nd = node(s);
+            nd->prev = npos;
+            nd->next = h;
+            nd->count = 0;
+            if (h != npos) {
+                node(h)->prev = s;
+            } else {
+                header()->tail = s;
+            }
+            header()->head = s;
+            h = s;
+        }
+        node_struct* n = node(h);
+        std::memmove(n->get_ptr(1), n->get_ptr(0), n->count * sizeof(T));
+        std::memcpy(n->get_ptr(0), &tmp, sizeof(T));
+        ++n->count;
+        ++header()->size;
+    }
+
+    void pop_back() noexcept {
+        std::uint64_t t = header()->tail;
+        if (t == npos) return;
+        node_struct* n = node(t);
+        --header()->size;
+        if (--n->count == 0) {
+            header()->tail = n->prev;
+            if (n->prev != npos) {
+                node(n->prev)->next = npos;
+            } else {
+                header()->head = npos;
+            }
+            free_slot(t);
+        }
+    }
+
+    void pop_front() noexcept {
+        std::uint64_t h = header()->head;
+        if (h == npos) return;
+        node_struct* n = node(h);
+        --header()->size;
+        if (--n->count == 0) {
+            header()->head = n->next;
+            if (n->next != npos) {
+                node(n->next)->prev = npos;
+            } else {
+                header()->tail = npos;
+            }
+            free_slot(h);
+        } else {
+            std::memmove(n->get_ptr(0), n->get_ptr(1), n->count * sizeof(T));
+        }
+    }
+
+    void clear() noexcept {
+        std::uint64_t s = header()->head;
+        while (s != npos) {
+            std::uint64_t next = node(s)->next;
+            free_slot(s);
+            s = next;
+        }
+        file_header* h = header();
+        h->head = h->tail = npos;
+        h->size = 0;
+    }
+
+private:
+    int           fd;
+    void*         base;
+    std::size_t   mapped_bytes;
+    std::uint64_t free_hint;
+
+    file_header* header() noexcept {
+        return static_cast<file_header*>(base);
+    }
+    const file_header* header() const noexcept {
+        return static_cast<const file_header*>(base);
+    }
+    unsigned char* segment(std::uint64_t seg) const noexcept {
+        return static_cast<unsigned char*>(base) + header_bytes + seg * segment_bytes;
+    }
+    std::uint64_t* bitmap(std::uint64_t seg) const noexcept {
+        return reinterpret_cast<std::uint64_t*>(segment(seg));
+    }
+    node_struct* node(std::uint64_t slot) const noexcept {
+        return reinterpret_cast<node_struct*>(segment(slot / slots_per_segment) + bitmap_bytes)
+               + slot % slots_per_segment;
+    }
+
+    std::uint64_t allocate_slot() {
+        std::uint64_t segments = header()->segment_count;
+        for (std::uint64_t k = 0; k < segments; ++k) {
+            std::uint64_t seg = (free_hint + k) % segments;
+            std::uint64_t* words = bitmap(seg);
+            for (std::size_t w = 0; w < bitmap_words; ++w) {
+                if (words[w] != ~std::uint64_t{0}) {
+                    std::size_t bit = std::countr_one(words[w]);
+                    words[w] |= std::uint64_t{1} << bit;
+                    free_hint = seg;
+                    ++header()->node_count;
+                    return seg * slots_per_segment + w * 64 + bit;
+                }
+            }
+        }
+        resize_file(header_bytes + (segments + 1) * segment_bytes);
+        std::memset(bitmap(segments), 0, bitmap_bytes);
+        header()->segment_count = segments + 1;
+        bitmap(segments)[0] = 1;
+        free_hint = segments;
+        ++header()->node_count;
+        return segments * slots_per_segment;
+    }
+    void free_slot(std::uint64_t slot) noexcept {
+        std::uint64_t seg = slot / slots_per_segment;
+        std::size_t within = slot % slots_per_segment;
+        bitmap(seg)[within / 64] &= ~(std::uint64_t{1} << (within % 64));
+        --header()->node_count;
+        free_hint = seg;
+    }
+
+    // Старое отображение снимается только после удачного mmap нового:
+    // при ошибке список остаётся на прежнем отображении и прежней длине файла.
+    void resize_file(std::size_t bytes) {
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "mapped_unrolled_list: ftruncate");
+        }
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            int err = errno;
+            // Если вернуть длину не удалось, файл остаётся длиннее;
+            // лишние байты после сегментов при открытии не мешают.
+            // Результат сохраняется в rc: с _FORTIFY_SOURCE GCC не принимает
+            // (void) прямо на вызове ftruncate.
+            if (base) {
+                int rc = ::ftruncate(fd, static_cast<off_t>(mapped_bytes));
+                (void)rc;
+            }
+            throw std::system_error(err, std::generic_category(), "mapped_unrolled_list: mmap");
+        }
+        unmap();
+        base = p;
+        mapped_bytes = bytes;
+    }
+    void map(std::size_t bytes) {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mapped_unrolled_list: mmap");
+        }
+        base = p;
+        mapped_bytes = bytes;
+    }
+    void unmap() noexcept {
+        if (base) {
+            ::munmap(base, mapped_bytes);
+            base = nullptr;
+            mapped_bytes = 0;
+        }
+    }
+    void close_file() noexcept {
+        unmap();
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+};
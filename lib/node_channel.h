@@ -0,0 +1,341 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+#if defined(__cpp_lib_generator)
+#include <generator>
+#endif
+
+#include "unrolled_node.h"
+
+#if defined(__cpp_lib_generator)
+template<typename Ref>
+using node_channel_generator = std::generator<Ref>;
+#else
+// Минимальная замена std::generator<Ref> до C++23: ленивый input-диапазон,
+// который возобновляет корутину на каждом ++.
+template<typename Ref>
+class node_channel_generator {
+public:
+    struct promise_type {
+        std::add_pointer_t<Ref> current = nullptr;
+        std::exception_ptr      error;
+
+        node_channel_generator get_return_object() noexcept {
+            return node_channel_generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+        std::suspend_always final_suspend() const noexcept {
+            return {};
+        }
+        std::suspend_always yield_value(Ref val) noexcept {
+            current = std::addressof(val);
+            return {};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept {
+            error = std::current_exception();
+        }
+    };
+
+    class iterator {
+    public:
+        using value_type      = std::remove_cvref_t<Ref>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() noexcept = default;
+        explicit iterator(std::coroutine_handle<promise_type> h) noexcept
+            : handle(h)
+        {}
+
+        Ref operator*() const noexcept {
+            return static_cast<Ref>(*handle.promise().current);
+        }
+        iterator& operator++() {
+            resume(handle);
+            return *this;
+        }
+        void operator++(int) {
+            ++(*this);
+        }
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return !handle || handle.done();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    node_channel_generator(node_channel_generator&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr))
+    {}
+    node_channel_generator& operator=(node_channel_generator other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~node_channel_generator() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    iterator begin() {
+        resume(handle);
+        return iterator(handle);
+    }
+    std::default_sentinel_t end() const noexcept {
+        return {};
+    }
+
+private:
+    explicit node_channel_generator(std::coroutine_handle<promise_type> h) noexcept
+        : handle(h)
+    {}
+
+    static void resume(std::coroutine_handle<promise_type> h) {
+        h.resume();
+        if (h.promise().error) {
+            std::rethrow_exception(std::exchange(h.promise().error, nullptr));
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+#endif
+
+// Канал между стадиями конвейера, передающий заполненные узлы. Производитель
+// пишет push(val) в собственный узел; как только в нём NodeMaxSize элементов,
+// узел целиком уходит в очередь потребителю, и тот обрабатывает его, пока
+// следующий ещё заполняется. close() отправляет неполный последний узел.
+//
+// В очереди не больше max_in_flight узлов: push на переполненный канал ждёт
+// потребителя, поэтому память ограничена max_in_flight + 1 узлом плюс узлами,
+// которые держит потребитель. Освобождённые узлы переиспользуются.
+//
+//     node_channel<row, 256> ch(4);
+//     std::thread producer([&] { for (...) ch.push(r); ch.close(); });
+//     for (auto&& batch : ch.batches()) {
+//         for (row& r : batch) { ... }
+//     }
+//
+// Один производитель и один или несколько потребителей. batch нельзя
+// держать дольше жизни канала.
+template<typename T, std::size_t NodeMaxSize = 256, typename Allocator = std::allocator<T>>
+class node_channel {
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using allocator_type = Allocator;
+
+private:
+    struct node_struct : unrolled_node_storage<T, NodeMaxSize> {
+        node_struct*                       next  = nullptr;
+        unrolled_list_count_t<NodeMaxSize> count = 0;
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+
+    node_alloc_type         node_alloc;
+    std::mutex              mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    node_struct*            ready_head = nullptr;
+    node_struct*            ready_tail = nullptr;
+    size_type               ready_count = 0;
+    node_struct*            free_nodes = nullptr;
+    size_type               allocated = 0;
+    size_type               max_in_flight;
+    bool                    closed = false;
+    // Принадлежит производителю, под mutex не нужен.
+    node_struct*            filling = nullptr;
+
+public:
+    // Заполненный узел, отданный потребителю. При разрушении элементы
+    // уничтожаются, а узел возвращается каналу.
+    class batch {
+    public:
+        batch(batch&& other) noexcept
+            : owner(std::exchange(other.owner, nullptr)), node(std::exchange(other.node, nullptr))
+        {}
+        batch& operator=(batch other) noexcept {
+            std::swap(owner, other.owner);
+            std::swap(node, other.node);
+            return *this;
+        }
+        ~batch() {
+            if (node) {
+                owner->recycle(node);
+            }
+        }
+
+        size_type size() const noexcept {
+            return node->count;
+        }
+        std::span<T> elements() const noexcept {
+            return std::span<T>(node->get_ptr(0), node->count);
+        }
+        T* begin() const noexcept {
+            return node->get_ptr(0);
+        }
+        T* end() const noexcept {
+            return node->get_ptr(node->count);
+        }
+
+    private:
+        friend class node_channel;
+
+        batch(node_channel* ch, node_struct* n) noexcept
+            : owner(ch), node(n)
+        {}
+
+        node_channel* owner;
+        node_struct*  node;
+    };
+
+    explicit node_channel(size_type max_in_flight_nodes = 4, const Allocator& alloc = Allocator())
+        : node_alloc(alloc), max_in_flight(max_in_flight_nodes > 0 ? max_in_flight_nodes : 1)
+    {}
+    node_channel(const node_channel&) = delete;
+    node_channel& operator=(const node_channel&) = delete;
+    ~node_channel() {
+        release_chain(ready_head, true);
+        if (filling) {
+            release_chain(filling, true);
+        }
+        release_chain(free_nodes, false);
+    }
+
+    void push(const T& val) {
+        emplace(val);
+    }
+    void push(T&& val) {
+        emplace(std::move(val));
+    }
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        if (!filling) {
+            filling = take_node();
+        }
+        new (static_cast<void*>(filling->get_ptr(filling->count))) T(std::forward<Args>(args)...);
+        if (++filling->count == NodeMaxSize) {
+            hand_off(std::exchange(filling, nullptr), false);
+        }
+    }
+    // Отправляет неполный узел и сообщает потребителям о конце данных.
+    void close() {
+        node_struct* last = std::exchange(filling, nullptr);
+        if (last && last->count == 0) {
+            recycle(last);
+            last = nullptr;
+        }
+        hand_off(last, true);
+    }
+
+    // Ждёт следующий узел; пустой optional — канал закрыт и опустошён.
+    std::optional<batch> pop() {
+        std::unique_lock lock(mutex);
+        not_empty.wait(lock, [&] { return ready_head || closed; });
+        if (!ready_head) {
+            return std::nullopt;
+        }
+        node_struct* n = ready_head;
+        ready_head = n->next;
+        if (!ready_head) {
+            ready_tail = nullptr;
+        }
+        --ready_count;
+        lock.unlock();
+        not_full.notify_one();
+        return batch(this, n);
+    }
+
+    // Узлы по мере готовности, до закрытия канала.
+    node_channel_generator<batch&&> batches() {
+        while (std::optional<batch> b = pop()) {
+            co_yield std::move(*b);
+        }
+    }
+
+    // Сколько узлов канал выделил за всё время; из-за переиспользования
+    // не превышает max_in_flight + 1 + число одновременно удерживаемых batch.
+    size_type nodes_allocated() {
+        std::lock_guard lock(mutex);
+        return allocated;
+    }
+
+private:
+    void hand_off(node_struct* n, bool close_after) {
+        {
+            std::unique_lock lock(mutex);
+            if (n) {
+                not_full.wait(lock, [&] { return ready_count < max_in_flight; });
+                n->next = nullptr;
+                if (ready_tail) {
+                    ready_tail->next = n;
+                } else {
+                    ready_head = n;
+                }
+                ready_tail = n;
+                ++ready_count;
+            }
+            closed = closed || close_after;
+        }
+        if (close_after) {
+            not_empty.notify_all();
+        } else {
+            not_empty.notify_one();
+        }
+    }
+
+    node_struct* take_node() {
+        {
+            std::lock_guard lock(mutex);
+            if (free_nodes) {
+                node_struct* n = free_nodes;
+                free_nodes = n->next;
+                n->next = nullptr;
+                n->count = 0;
+                return n;
+            }
+        }
+        node_struct* n = new (static_cast<void*>(node_alloc.allocate(1))) node_struct;
+        std::lock_guard lock(mutex);
+        ++allocated;
+        return n;
+    }
+    void recycle(node_struct* n) noexcept {
+        for (std::size_t i = 0; i < n->count; ++i) {
+            n->destroy_elem(i);
+        }
+        n->count = 0;
+        std::lock_guard lock(mutex);
+        n->next = free_nodes;
+        free_nodes = n;
+    }
+    void release_chain(node_struct* n, bool with_elements) noexcept {
+        while (n) {
+            node_struct* next = n->next;
+            if (with_elements) {
+                for (std::size_t i = 0; i < n->count; ++i) {
+                    n->destroy_elem(i);
+                }
+            }
+            n->~node_struct();
+            node_alloc.deallocate(n, 1);
+            n = next;
+        }
+    }
+};
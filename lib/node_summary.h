@@ -0,0 +1,72 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <functional>
+
+// Сводки узлов для unrolled_list: подключаются через политику
+//
+//     struct by_price : unrolled_list_policy {
+//         using summary = minmax_summary<double, price_of>;
+//     };
+//
+// и позволяют scan() пропускать узлы, в которых заведомо нет нужных элементов.
+// Proj — функциональный объект, который достаёт ключ из элемента.
+
+template<typename Key, typename Proj>
+struct minmax_summary {
+    Key  min{};
+    Key  max{};
+    bool empty = true;
+
+    template<typename T>
+    void add(const T& val) noexcept {
+        Key key = Proj{}(val);
+        if (empty) {
+            min = max = key;
+            empty = false;
+        } else {
+            if (key < min) min = key;
+            if (max < key) max = key;
+        }
+    }
+    void reset() noexcept {
+        empty = true;
+    }
+
+    bool may_contain(const Key& key) const noexcept {
+        return !empty && !(key < min) && !(max < key);
+    }
+    bool may_intersect(const Key& lo, const Key& hi) const noexcept {
+        return !empty && !(max < lo) && !(hi < min);
+    }
+};
+
+// Фильтр Блума на Bits бит с двумя хеш-функциями, выведенными из std::hash<Key>.
+template<typename Key, typename Proj, std::size_t Bits = 64>
+struct bloom_summary {
+    std::bitset<Bits> bits;
+
+    template<typename T>
+    void add(const T& val) noexcept {
+        std::size_t h = std::hash<Key>{}(Proj{}(val));
+        bits.set(first_bit(h));
+        bits.set(second_bit(h));
+    }
+    void reset() noexcept {
+        bits.reset();
+    }
+
+    bool may_contain(const Key& key) const noexcept {
+        std::size_t h = std::hash<Key>{}(key);
+        return bits.test(first_bit(h)) && bits.test(second_bit(h));
+    }
+
+private:
+    static std::size_t first_bit(std::size_t h) noexcept {
+        return h % Bits;
+    }
+    static std::size_t second_bit(std::size_t h) noexcept {
+        return ((h >> 17) ^ (h * 0x9E3779B97F4A7C15ull)) % Bits;
+    }
+};
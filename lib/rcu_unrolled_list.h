@@ -0,0 +1,461 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+// Список для сценария "один писатель, много читателей".
+// Читатели обходят список без блокировок внутри read_guard. Писатель дописывает
+// элементы в хвостовой узел на месте (читатели не заходят дальше опубликованного
+// count), а любое другое изменение узла делает на его копии и подменяет ссылку
+// на неё одной атомарной записью. Вытесненные узлы освобождаются, когда все
+// читатели, которые могли их видеть, вышли из read_guard.
+//
+// MaxReaders — число одновременно живых read_guard. Каждый занимает слот;
+// если все слоты заняты, конструктор read_guard ждёт (yield в цикле), пока
+// какой-нибудь читатель не выйдет, и без выходов ждёт бесконечно. Поэтому
+// MaxReaders должен быть не меньше числа одновременно читающих потоков;
+// вложенные read_guard одного потока занимают по слоту каждый.
+template<typename T, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>, std::size_t MaxReaders = 64>
+class rcu_unrolled_list {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+private:
+    struct node_struct {
+        std::atomic<node_struct*> next;
+        node_struct* prev;
+        std::atomic<std::size_t> count;
+        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+        node_struct() : next(nullptr), prev(nullptr), count(0) {}
+
+        T* get_ptr(std::size_t i) {
+            return reinterpret_cast<T*>(storage + i * sizeof(T));
+        }
+        const T* get_ptr(std::size_t i) const {
+            return reinterpret_cast<const T*>(storage + i * sizeof(T));
+        }
+        template<typename... Args>
+        void construct_elem(std::size_t idx, Args&&... args) {
+            new (static_cast<void*>(get_ptr(idx))) T(std::forward<Args>(args)...);
+        }
+        void destroy_elem(std::size_t idx) noexcept {
+            get_ptr(idx)->~T();
+        }
+    };
+
+    struct retired_node {
+        node_struct*  node;
+        std::uint64_t epoch;
+    };
+
+    struct alignas(64) reader_slot {
+        std::atomic<std::uint64_t> epoch{0};
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+
+    static constexpr std::size_t reclaim_threshold = 64;
+
+    node_alloc_type           node_alloc;
+    allocator_type            val_alloc;
+    std::atomic<node_struct*> head;
+    node_struct*              tail;
+    size_type                 size_;
+    std::vector<retired_node> retired;
+
+    std::atomic<std::uint64_t> global_epoch;
+    mutable reader_slot        readers[MaxReaders];
+
+public:
+    class const_iterator {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        const_iterator() : node_ptr(nullptr), index(0), count(0) {}
+        explicit const_iterator(const node_struct* n)
+            : node_ptr(n), index(0), count(n ? n->count.load(std::memory_order_acquire) : 0)
+        {}
+
+        reference operator*() const {
+            return *(node_ptr->get_ptr(index));
+        }
+        pointer operator->() const {
+            return node_ptr->get_ptr(index);
+        }
+
+        // Хвостовой узел мог пополниться после входа в него, поэтому перед
+        // переходом count перечитывается после загрузки next.
+        const_iterator& operator++() {
+            if (++index == count) {
+                const node_struct* nx = node_ptr->next.load(std::memory_order_acquire);
+                count = node_ptr->count.load(std::memory_order_acquire);
+                if (index == count) {
+                    *this = const_iterator(nx);
+                }
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return (node_ptr == other.node_ptr) && (index == other.index);
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const node_struct* node_ptr;
+        std::size_t        index;
+        std::size_t        count;
+    };
+
+    // Пока жив read_guard, узлы, достижимые из его begin(), не освобождаются.
+    class read_guard {
+    public:
+        explicit read_guard(const rcu_unrolled_list& list)
+            : slot(list.enter_reader()), first(list.head.load(std::memory_order_acquire))
+        {}
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+        ~read_guard() {
+            slot->epoch.store(0, std::memory_order_release);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(first);
+        }
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+    private:
+        reader_slot*       slot;
+        const node_struct* first;
+    };
+
+    rcu_unrolled_list()
+        : rcu_unrolled_list(allocator_type())
+    {}
+    explicit rcu_unrolled_list(const allocator_type& alloc)
+        : node_alloc(alloc), val_alloc(alloc), head(nullptr), tail(nullptr), size_(0), global_epoch(1)
+    {}
+
+    rcu_unrolled_list(const rcu_unrolled_list&) = delete;
+    rcu_unrolled_list& operator=(const rcu_unrolled_list&) = delete;
+
+    // К моменту разрушения читателей быть не должно.
+    ~rcu_unrolled_list() {
+        node_struct* cur_node = head.load(std::memory_order_relaxed);
+        while (cur_node) {
+            node_struct* next_node = cur_node->next.load(std::memory_order_relaxed);
+            free_node(cur_node);
+            cur_node = next_node;
+        }
+        for (auto& r : retired) {
+            free_node(r.node);
+        }
+    }
+
+    read_guard read_lock() const {
+        return read_guard(*this);
+    }
+
+    allocator_type get_allocator() const {
+        return val_alloc;
+    }
+
+    // Дальше — операции писателя. Вызывать их может только один поток.
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return (size_ == 0);
+    }
+
+    void push_back(const T& val) {
+        emplace_back(val);
+    }
+    void push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        if (tail) {
+            std::size_t cnt = tail->count.load(std::memory_order_relaxed);
+            if (cnt < NodeMaxSize) {
+                tail->construct_elem(cnt, std::forward<Args>(args)...);
+                tail->count.store(cnt + 1, std::memory_order_release);
+                ++size_;
+                return;
+            }
+        }
+        node_struct* nd = allocate_node();
+        try {
+            nd->construct_elem(0, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate_node(nd);
+            throw;
+        }
+        nd->count.store(1, std::memory_order_relaxed);
+        nd->prev = tail;
+        if (tail) {
+            tail->next.store(nd, std::memory_order_release);
+        } else {
+            head.store(nd, std::memory_order_release);
+        }
+        tail = nd;
+        ++size_;
+    }
+
+    void push_front(const T& val) {
+        insert(0, val);
+    }
+
+    void insert(size_type pos, const T& val) {
+        if (pos >= size_) {
+            push_back(val);
+            return;
+        }
+        auto [n, idx] = locate(pos);
+        std::size_t cnt = n->count.load(std::memory_order_relaxed);
+        retired.reserve(retired.size() + 1);
+        if (cnt < NodeMaxSize) {
+            node_builder copy(*this);
+            copy.append_range(n, 0, idx);
+            copy.append(val);
+            copy.append_range(n, idx, cnt);
+            node_struct* nd = copy.release();
+            replace(n, nd, nd);
+        } else {
+            std::size_t half = cnt / 2;
+            node_builder left(*this);
+            node_builder right(*this);
+            if (idx < half) {
+                left.append_range(n, 0, idx);
+                left.append(val);
+                left.append_range(n, idx, half);
+                right.append_range(n, half, cnt);
+            } else {
+                left.append_range(n, 0, half);
+                right.append_range(n, half, idx);
+                right.append(val);
+                right.append_range(n, idx, cnt);
+            }
+            node_struct* l = left.release();
+            node_struct* r = right.release();
+            l->next.store(r, std::memory_order_relaxed);
+            r->prev = l;
+            replace(n, l, r);
+        }
+        ++size_;
+    }
+
+    void erase(size_type pos) {
+        auto [n, idx] = locate(pos);
+        std::size_t cnt = n->count.load(std::memory_order_relaxed);
+        retired.reserve(retired.size() + 1);
+        if (cnt == 1) {
+            replace(n, nullptr, nullptr);
+        } else {
+            node_builder copy(*this);
+            copy.append_range(n, 0, idx);
+            copy.append_range(n, idx + 1, cnt);
+            node_struct* nd = copy.release();
+            replace(n, nd, nd);
+        }
+        --size_;
+    }
+
+    void pop_front() {
+        if (size_) erase(0);
+    }
+
+    void clear() {
+        node_struct* cur_node = head.load(std::memory_order_relaxed);
+        std::size_t nodes = 0;
+        for (node_struct* n = cur_node; n; n = n->next.load(std::memory_order_relaxed)) {
+            ++nodes;
+        }
+        retired.reserve(retired.size() + nodes);
+        head.store(nullptr, std::memory_order_release);
+        tail = nullptr;
+        size_ = 0;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t epoch = global_epoch.fetch_add(1);
+        while (cur_node) {
+            retired.push_back({cur_node, epoch});
+            cur_node = cur_node->next.load(std::memory_order_relaxed);
+        }
+        reclaim();
+    }
+
+    // Освобождает вытесненные узлы, которые уже не может видеть ни один читатель.
+    size_type reclaim() {
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        for (auto& slot : readers) {
+            std::uint64_t e = slot.epoch.load(std::memory_order_acquire);
+            if (e != 0 && e < oldest) oldest = e;
+        }
+        size_type freed = 0;
+        std::size_t kept = 0;
+        for (auto& r : retired) {
+            if (r.epoch < oldest) {
+                free_node(r.node);
+                ++freed;
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+        return freed;
+    }
+
+    // Ждёт окончания периода ожидания для всех уже вытесненных узлов.
+    void synchronize() {
+        while (reclaim(), !retired.empty()) {
+            std::this_thread::yield();
+        }
+    }
+
+    size_type retired_count() const noexcept {
+        return retired.size();
+    }
+
+private:
+    // Поиск свободного слота начинается с последнего слота этого потока
+    // (сначала — со слота по хешу id потока), и занятые слоты проверяются
+    // обычной загрузкой: CAS забирает строку кэша монопольно даже при неудаче,
+    // и читатели, начинающие с нулевого слота, мешали бы друг другу.
+    // Когда свободных слотов нет, ждёт освобождения (см. MaxReaders).
+    reader_slot* enter_reader() const {
+        thread_local std::size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        for (;;) {
+            for (std::size_t k = 0; k < MaxReaders; ++k) {
+                std::size_t i = (hint + k) % MaxReaders;
+                reader_slot& slot = readers[i];
+                if (slot.epoch.load(std::memory_order_relaxed) != 0) continue;
+                std::uint64_t expected = 0;
+                std::uint64_t epoch = global_epoch.load();
+                if (slot.epoch.compare_exchange_strong(expected, epoch)) {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    hint = i;
+                    return &slot;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    std::pair<node_struct*, std::size_t> locate(size_type pos) const {
+        node_struct* n = head.load(std::memory_order_relaxed);
+        std::size_t cnt = n->count.load(std::memory_order_relaxed);
+        while (pos >= cnt) {
+            pos -= cnt;
+            n = n->next.load(std::memory_order_relaxed);
+            cnt = n->count.load(std::memory_order_relaxed);
+        }
+        return {n, pos};
+    }
+
+    // Собирает новый узел из копий; если сборка прервалась исключением,
+    // недостроенный узел освобождается.
+    struct node_builder {
+        rcu_unrolled_list& list;
+        node_struct*       node;
+
+        explicit node_builder(rcu_unrolled_list& l) : list(l), node(l.allocate_node()) {}
+        ~node_builder() {
+            if (node) list.free_node(node);
+        }
+
+        void append(const T& val) {
+            std::size_t cnt = node->count.load(std::memory_order_relaxed);
+            node->construct_elem(cnt, val);
+            node->count.store(cnt + 1, std::memory_order_relaxed);
+        }
+        void append_range(const node_struct* src, std::size_t from, std::size_t to) {
+            for (std::size_t i = from; i < to; ++i) {
+                append(*src->get_ptr(i));
+            }
+        }
+        node_struct* release() noexcept {
+            return std::exchange(node, nullptr);
+        }
+    };
+
+    // Подменяет узел n цепочкой [first, last] (или вырезает его, если first == nullptr)
+    // и отправляет n в очередь на освобождение.
+    void replace(node_struct* n, node_struct* first, node_struct* last) {
+        node_struct* p = n->prev;
+        node_struct* nx = n->next.load(std::memory_order_relaxed);
+        if (first) {
+            first->prev = p;
+            last->next.store(nx, std::memory_order_relaxed);
+        } else {
+            first = nx;
+            last = p;
+        }
+        if (p) {
+            p->next.store(first, std::memory_order_release);
+        } else {
+            head.store(first, std::memory_order_release);
+        }
+        if (nx) {
+            nx->prev = last;
+        } else {
+            tail = last;
+        }
+        retire(n);
+    }
+
+    void retire(node_struct* n) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        retired.push_back({n, global_epoch.fetch_add(1)});
+        if (retired.size() >= reclaim_threshold) {
+            reclaim();
+        }
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct();
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+    void free_node(node_struct* nd) noexcept {
+        std::size_t cnt = nd->count.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < cnt; ++i) {
+            nd->destroy_elem(i);
+        }
+        deallocate_node(nd);
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "unrolled_list.h"
+
+// Дописывание из нескольких потоков без общей блокировки. Каждый поток
+// пишет в свой шард — отдельный unrolled_list со своей цепочкой узлов:
+//
+//     sharded_appender<result, 64> out(threads);
+//     // в потоке i:
+//     out.shard(i).push_back(r);
+//     // после join:
+//     unrolled_list<result, 64> all = out.collect();
+//
+// collect() сцепляет шарды по порядку номеров перевязкой узлов, за
+// O(числа шардов), и оставляет шарды пустыми. Один шард может писать
+// только один поток одновременно; collect() вызывается, когда писатели
+// закончили.
+template<typename T, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>, typename Policy = unrolled_list_policy>
+class sharded_appender {
+public:
+    using list_type = unrolled_list<T, NodeMaxSize, Allocator, Policy>;
+    using size_type = std::size_t;
+
+    explicit sharded_appender(size_type shards, const Allocator& alloc = Allocator())
+        : shards_()
+    {
+        shards_.reserve(shards);
+        for (size_type i = 0; i < shards; ++i) {
+            shards_.emplace_back(alloc);
+        }
+    }
+
+    size_type shard_count() const noexcept {
+        return shards_.size();
+    }
+    list_type& shard(size_type i) noexcept {
+        return shards_[i].list;
+    }
+    const list_type& shard(size_type i) const noexcept {
+        return shards_[i].list;
+    }
+
+    list_type collect() {
+        list_type result(shards_.empty() ? Allocator() : shards_.front().list.get_allocator());
+        for (padded_shard& s : shards_) {
+            result.splice_back(std::move(s.list));
+        }
+        return result;
+    }
+
+private:
+    // Заголовки соседних шардов не должны делить строку кэша: push_back
+    // из разных потоков пишет в tail и size_ своего шарда.
+    struct alignas(64) padded_shard {
+        list_type list;
+
+        explicit padded_shard(const Allocator& alloc)
+            : list(alloc)
+        {}
+    };
+
+    std::vector<padded_shard> shards_;
+};
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Блочный список, в узле которого каждое поле элемента хранится отдельным
+// массивом (structure of arrays). Поля перечисляются указателями на члены:
+//
+//     struct order { std::uint64_t id; double price; std::uint32_t qty; };
+//     soa_unrolled_list<order, 64, &order::id, &order::price, &order::qty> orders;
+//
+// Элемент целиком собирается из полей по требованию, поэтому разыменование
+// итератора возвращает прокси-ссылку. Проход по одному полю —
+// for_each_segment<&order::price>(fn) — читает только его массивы.
+// Поля должны быть тривиальными типами, T — конструируемым по умолчанию.
+// Хранятся только перечисленные поля: неперечисленное поле T при записи
+// теряется, а при чтении получает значение по умолчанию (T val{}). Поэтому
+// в Members должны быть все поля T; static_assert ловит пропуск поля,
+// которое не помещается в выравнивание между остальными.
+
+template<auto Member>
+struct soa_member_traits;
+
+template<typename C, typename F, F C::*Member>
+struct soa_member_traits<Member> {
+    using class_type = C;
+    using field_type = F;
+};
+
+template<typename T, std::size_t NodeMaxSize, auto... Members>
+class soa_unrolled_list {
+    static_assert(sizeof...(Members) > 0, "soa_unrolled_list needs at least one field");
+    static_assert((std::is_same_v<typename soa_member_traits<Members>::class_type, T> && ...),
+                  "all fields must be members of T");
+    static_assert((std::is_trivial_v<typename soa_member_traits<Members>::field_type> && ...),
+                  "fields must be trivial types");
+    static_assert(std::is_default_constructible_v<T>, "T is rebuilt from its fields");
+    // Даже если каждое поле занимает отдельный кусок по alignof(T), T не
+    // может быть больше; иначе у T есть поля не из Members.
+    static_assert(sizeof(T) <= (0 + ... + ((sizeof(typename soa_member_traits<Members>::field_type) + alignof(T) - 1)
+                                           / alignof(T) * alignof(T))),
+                  "every field of T must be listed in Members");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<auto Member>
+    using field_type = typename soa_member_traits<Member>::field_type;
+
+private:
+    static constexpr std::size_t field_count = sizeof...(Members);
+
+    template<auto A, auto B>
+    static constexpr bool same_member() {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        } else {
+            return false;
+        }
+    }
+    template<auto Member>
+    static constexpr std::size_t field_index() {
+        constexpr bool matches[] = {same_member<Member, Members>()...};
+        for (std::size_t i = 0; i < field_count; ++i) {
+            if (matches[i]) return i;
+        }
+        return field_count;
+    }
+
+    struct node_struct {
+        node_struct* prev = nullptr;
+        node_struct* next = nullptr;
+        std::size_t  count = 0;
+        std::tuple<std::array<field_type<Members>, NodeMaxSize>...> columns;
+
+        template<auto Member>
+        field_type<Member>* column() noexcept {
+            return std::get<field_index<Member>()>(columns).data();
+        }
+
+        T load(std::size_t i) const {
+            T val{};
+            load_into(val, i, std::make_index_sequence<field_count>{});
+            return val;
+        }
+        void store(std::size_t i, const T& val) noexcept {
+            store_from(val, i, std::make_index_sequence<field_count>{});
+        }
+        // Переносит n элементов с позиции from на позицию to во всех столбцах.
+        void move_range(std::size_t from, std::size_t to, std::size_t n) noexcept {
+            std::apply([&](auto&... col) {
+                (std::memmove(col.data() + to, col.data() + from, n * sizeof(col[0])), ...);
+            }, columns);
+        }
+
+    private:
+        template<std::size_t... I>
+        void load_into(T& val, std::size_t i, std::index_sequence<I...>) const {
+            ((val.*Members = std::get<I>(columns)[i]), ...);
+        }
+        template<std::size_t... I>
+        void store_from(const T& val, std::size_t i, std::index_sequence<I...>) noexcept {
+            ((std::get<I>(columns)[i] = val.*Members), ...);
+        }
+    };
+
+    using node_alloc_type = std::allocator<node_struct>;
+
+    node_alloc_type node_alloc;
+    node_struct*    head;
+    node_struct*    tail;
+    size_type       size_;
+
+public:
+    // Ссылка на элемент в узле: get<&T::field>() даёт ссылку на поле,
+    // преобразование к T собирает элемент, присваивание T раскладывает его.
+    template<bool is_const>
+    class reference_proxy {
+    public:
+        template<auto Member>
+        using field_reference = std::conditional_t<is_const, const field_type<Member>&, field_type<Member>&>;
+
+        reference_proxy(node_struct* n, std::size_t i) noexcept
+            : node(n), index(i)
+        {}
+
+        template<auto Member>
+        field_reference<Member> get() const noexcept {
+            return node->template column<Member>()[index];
+        }
+
+        operator T() const {
+            return node->load(index);
+        }
+        reference_proxy(const reference_proxy&) = default;
+
+        reference_proxy& operator=(const T& val) noexcept requires (!is_const) {
+            node->store(index, val);
+            return *this;
+        }
+        // Присваивание прокси копирует значение, а не перенаправляет ссылку.
+        reference_proxy& operator=(const reference_proxy& other) noexcept requires (!is_const) {
+            node->store(index, static_cast<T>(other));
+            return *this;
+        }
+
+    private:
+        node_struct* node;
+        std::size_t  index;
+    };
+
+    using reference       = reference_proxy<false>;
+    using const_reference = reference_proxy<true>;
+
+    template<bool is_const>
+    class iterators_class {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using reference         = reference_proxy<is_const>;
+
+        iterators_class(node_struct* n = nullptr, std::size_t i = 0) noexcept
+            : node_ptr(n), index(i)
+        {}
+
+        template<bool B, typename = std::enable_if_t<!B && is_const>>
+        iterators_class(const iterators_class<B>& other) noexcept
+            : node_ptr(other.node_ptr), index(other.index)
+        {}
+
+        reference operator*() const noexcept {
+            return reference(node_ptr, index);
+        }
+
+        iterators_class& operator++() noexcept {
+            if (++index == node_ptr->count) {
+                node_ptr = node_ptr->next;
+                index = 0;
+            }
+            return *this;
+        }
+        iterators_class operator++(int) noexcept {
+            iterators_class tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+        iterators_class& operator--() noexcept {
+            if (index == 0) {
+                node_ptr = node_ptr->prev;
+                index = node_ptr->count;
+            }
+            --index;
+            return *this;
+        }
+        iterators_class operator--(int) noexcept {
+            iterators_class tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterators_class& other) const noexcept {
+            return node_ptr == other.node_ptr && index == other.index;
+        }
+        bool operator!=(const iterators_class& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        template<bool> friend class iterators_class;
+
+        node_struct* node_ptr;
+        std::size_t  index;
+    };
+
+    using iterator       = iterators_class<false>;
+    using const_iterator = iterators_class<true>;
+
+    soa_unrolled_list() noexcept
+        : head(nullptr), tail(nullptr), size_(0)
+    {}
+    soa_unrolled_list(std::initializer_list<T> il)
+        : soa_unrolled_list()
+    {
+        for (const T& val : il) {
+            push_back(val);
+        }
+    }
+    soa_unrolled_list(const soa_unrolled_list& other)
+        : soa_unrolled_list()
+    {
+        for (node_struct* n = other.head; n; n = n->next) {
+            node_struct* nd = allocate_node();
+            nd->columns = n->columns;
+            nd->count = n->count;
+            link_back(nd);
+            size_ += n->count;
+        }
+    }
+    soa_unrolled_list(soa_unrolled_list&& other) noexcept
+        : soa_unrolled_list()
+    {
+        swap(other);
+    }
+    soa_unrolled_list& operator=(const soa_unrolled_list& other) {
+        if (this != &other) {
+            soa_unrolled_list tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    soa_unrolled_list& operator=(soa_unrolled_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+    ~soa_unrolled_list() {
+        clear();
+    }
+
+    void swap(soa_unrolled_list& other) noexcept {
+        std::swap(head,  other.head);
+        std::swap(tail,  other.tail);
+        std::swap(size_, other.size_);
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    iterator begin() noexcept {
+        return iterator(head, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(head, 0);
+    }
+    iterator end() noexcept {
+        return iterator(nullptr, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr, 0);
+    }
+
+    reference front() noexcept {
+        return reference(head, 0);
+    }
+    const_reference front() const noexcept {
+        return const_reference(head, 0);
+    }
+    reference back() noexcept {
+        return reference(tail, tail->count - 1);
+    }
+    const_reference back() const noexcept {
+        return const_reference(tail, tail->count - 1);
+    }
+
+    void push_back(const T& val) {
+        if (!tail || tail->count == NodeMaxSize) {
+            link_back(allocate_node());
+        }
+        tail->store(tail->count++, val);
+        ++size_;
+    }
+    void push_front(const T& val) {
+        if (!head || head->count == NodeMaxSize) {
+            node_struct* nd = allocate_node();
+            nd->next = head;
+            if (head) {
+                head->prev = nd;
+            } else {
+                tail = nd;
+            }
+            head = nd;
+        }
+        head->move_range(0, 1, head->count);
+        head->store(0, val);
+        ++head->count;
+        ++size_;
+    }
+    void pop_back() noexcept {
+        if (!tail) return;
+        --size_;
+        if (--tail->count == 0) {
+            unlink(tail);
+        }
+    }
+    void pop_front() noexcept {
+        if (!head) return;
+        --size_;
+        if (--head->count == 0) {
+            unlink(head);
+        } else {
+            head->move_range(1, 0, head->count);
+        }
+    }
+
+    void clear() noexcept {
+        while (head) {
+            node_struct* next = head->next;
+            deallocate_node(head);
+            head = next;
+        }
+        tail = nullptr;
+        size_ = 0;
+    }
+
+    // Вызывает fn(std::span<const F>) для заполненной части столбца Member
+    // в каждом узле.
+    template<auto Member, typename Fn>
+    void for_each_segment(Fn fn) const {
+        for (node_struct* n = head; n; n = n->next) {
+            fn(std::span<const field_type<Member>>(n->template column<Member>(), n->count));
+        }
+    }
+    // То же для изменения поля на месте.
+    template<auto Member, typename Fn>
+    void for_each_segment_mut(Fn fn) {
+        for (node_struct* n = head; n; n = n->next) {
+            fn(std::span<field_type<Member>>(n->template column<Member>(), n->count));
+        }
+    }
+
+private:
+    void link_back(node_struct* nd) noexcept {
+        nd->prev = tail;
+        if (tail) {
+            tail->next = nd;
+        } else {
+            head = nd;
+        }
+        tail = nd;
+    }
+    void unlink(node_struct* n) noexcept {
+        if (n->prev) {
+            n->prev->next = n->next;
+        } else {
+            head = n->next;
+        }
+        if (n->next) {
+            n->next->prev = n->prev;
+        } else {
+            tail = n->prev;
+        }
+        deallocate_node(n);
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct;
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
@@ -0,0 +1,460 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+// Упорядоченный блочный список. Внутри узла элементы лежат отсортированными
+// в непрерывном storage, поэтому первый и последний ключ узла — это его
+// крайние ячейки. Узлы перечислены в непрерывном каталоге, и поиск сначала
+// делит пополам каталог по последнему ключу узла, а затем — storage найденного
+// узла: O(log(n / NodeMaxSize) + log NodeMaxSize) сравнений.
+// Вставка и удаление сдвигают не более NodeMaxSize элементов и указатели каталога.
+template<typename T, typename Compare = std::less<T>, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+class sorted_unrolled_list {
+    static_assert(NodeMaxSize >= 2, "sorted_unrolled_list needs at least two elements per node to split");
+
+public:
+    using value_type      = T;
+    using key_type        = T;
+    using key_compare     = Compare;
+    using reference       = const T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+private:
+    struct node_struct {
+        std::size_t count;
+        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+        node_struct() : count(0) {}
+
+        T* get_ptr(std::size_t i) {
+            return reinterpret_cast<T*>(storage + i * sizeof(T));
+        }
+        const T* get_ptr(std::size_t i) const {
+            return reinterpret_cast<const T*>(storage + i * sizeof(T));
+        }
+        const T* begin() const {
+            return get_ptr(0);
+        }
+        const T* end() const {
+            return get_ptr(count);
+        }
+        const T& first_key() const {
+            return *get_ptr(0);
+        }
+        const T& last_key() const {
+            return *get_ptr(count - 1);
+        }
+
+        template<typename... Args>
+        void construct_elem(std::size_t idx, Args&&... args) {
+            new (static_cast<void*>(get_ptr(idx))) T(std::forward<Args>(args)...);
+        }
+        void destroy_elem(std::size_t idx) noexcept {
+            get_ptr(idx)->~T();
+        }
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+    using dir_alloc_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct*>;
+
+    node_alloc_type                              node_alloc;
+    allocator_type                               val_alloc;
+    std::vector<node_struct*, dir_alloc_type>    nodes;
+    size_type                                    size_;
+    [[no_unique_address]] Compare                comp;
+
+public:
+    class const_iterator {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        const_iterator() : dir(nullptr), node_index(0), index(0) {}
+        const_iterator(const std::vector<node_struct*, dir_alloc_type>* d, std::size_t n, std::size_t i)
+            : dir(d), node_index(n), index(i)
+        {}
+
+        reference operator*() const {
+            return *((*dir)[node_index]->get_ptr(index));
+        }
+        pointer operator->() const {
+            return (*dir)[node_index]->get_ptr(index);
+        }
+
+        const_iterator& operator++() {
+            if (++index == (*dir)[node_index]->count) {
+                ++node_index;
+                index = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+        const_iterator& operator--() {
+            if (index == 0) {
+                --node_index;
+                index = (*dir)[node_index]->count;
+            }
+            --index;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return (node_index == other.node_index) && (index == other.index);
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class sorted_unrolled_list;
+
+        const std::vector<node_struct*, dir_alloc_type>* dir;
+        std::size_t node_index;
+        std::size_t index;
+    };
+
+    using iterator = const_iterator;
+
+    sorted_unrolled_list()
+        : sorted_unrolled_list(Compare(), allocator_type())
+    {}
+    explicit sorted_unrolled_list(const Compare& cmp, const allocator_type& alloc = allocator_type())
+        : node_alloc(alloc), val_alloc(alloc), nodes(dir_alloc_type(alloc)), size_(0), comp(cmp)
+    {}
+    explicit sorted_unrolled_list(const allocator_type& alloc)
+        : sorted_unrolled_list(Compare(), alloc)
+    {}
+
+    template<typename InputIt>
+    sorted_unrolled_list(InputIt first, InputIt last, const Compare& cmp = Compare(), const allocator_type& alloc = allocator_type())
+        : sorted_unrolled_list(cmp, alloc)
+    {
+        try {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    sorted_unrolled_list(std::initializer_list<T> il, const Compare& cmp = Compare(), const allocator_type& alloc = allocator_type())
+        : sorted_unrolled_list(il.begin(), il.end(), cmp, alloc)
+    {}
+
+    sorted_unrolled_list(const sorted_unrolled_list& other)
+        : sorted_unrolled_list(other.comp, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.val_alloc))
+    {
+        try {
+            nodes.reserve(other.nodes.size());
+            for (const node_struct* src : other.nodes) {
+                node_struct* nd = allocate_node();
+                nodes.push_back(nd);
+                for (std::size_t i = 0; i < src->count; ++i) {
+                    nd->construct_elem(i, *src->get_ptr(i));
+                    nd->count = i + 1;
+                }
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        size_ = other.size_;
+    }
+    sorted_unrolled_list(sorted_unrolled_list&& other) noexcept
+        : node_alloc(std::move(other.node_alloc)),
+          val_alloc(std::move(other.val_alloc)),
+          nodes(std::move(other.nodes)),
+          size_(std::exchange(other.size_, 0)),
+          comp(std::move(other.comp))
+    {
+        other.nodes.clear();
+    }
+
+    ~sorted_unrolled_list() {
+        clear();
+    }
+
+    sorted_unrolled_list& operator=(const sorted_unrolled_list& other) {
+        if (this != &other) {
+            sorted_unrolled_list tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    sorted_unrolled_list& operator=(sorted_unrolled_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void swap(sorted_unrolled_list& other) noexcept {
+        using std::swap;
+        swap(node_alloc, other.node_alloc);
+        swap(val_alloc,  other.val_alloc);
+        swap(nodes,      other.nodes);
+        swap(size_,      other.size_);
+        swap(comp,       other.comp);
+    }
+
+    allocator_type get_allocator() const {
+        return val_alloc;
+    }
+    key_compare key_comp() const {
+        return comp;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return (size_ == 0);
+    }
+    size_type node_count() const noexcept {
+        return nodes.size();
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(&nodes, 0, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(&nodes, nodes.size(), 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    const T& front() const {
+        return nodes.front()->first_key();
+    }
+    const T& back() const {
+        return nodes.back()->last_key();
+    }
+
+    void clear() noexcept {
+        for (node_struct* nd : nodes) {
+            for (std::size_t i = 0; i < nd->count; ++i) {
+                nd->destroy_elem(i);
+            }
+            deallocate_node(nd);
+        }
+        nodes.clear();
+        size_ = 0;
+    }
+
+    // Равные ключи сохраняют порядок вставки: новый элемент встаёт после них.
+    const_iterator insert(const T& val) {
+        return emplace_value(val);
+    }
+    const_iterator insert(T&& val) {
+        return emplace_value(std::move(val));
+    }
+
+    const_iterator lower_bound(const T& key) const {
+        std::size_t n = first_node_where([&](const node_struct* nd) { return !comp(nd->last_key(), key); });
+        if (n == nodes.size()) return end();
+        const node_struct* nd = nodes[n];
+        return const_iterator(&nodes, n, std::lower_bound(nd->begin(), nd->end(), key, comp) - nd->begin());
+    }
+    const_iterator upper_bound(const T& key) const {
+        std::size_t n = first_node_where([&](const node_struct* nd) { return comp(key, nd->last_key()); });
+        if (n == nodes.size()) return end();
+        const node_struct* nd = nodes[n];
+        return const_iterator(&nodes, n, std::upper_bound(nd->begin(), nd->end(), key, comp) - nd->begin());
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const T& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    const_iterator find(const T& key) const {
+        const_iterator it = lower_bound(key);
+        if (it != end() && !comp(key, *it)) return it;
+        return end();
+    }
+    bool contains(const T& key) const {
+        return find(key) != end();
+    }
+    size_type count(const T& key) const {
+        auto [first, last] = equal_range(key);
+        return static_cast<size_type>(std::distance(first, last));
+    }
+
+    const_iterator erase(const_iterator pos) {
+        std::size_t n = pos.node_index;
+        node_struct* nd = nodes[n];
+        for (std::size_t i = pos.index; i + 1 < nd->count; ++i) {
+            *nd->get_ptr(i) = std::move(*nd->get_ptr(i + 1));
+        }
+        nd->destroy_elem(--nd->count);
+        --size_;
+
+        std::size_t idx = pos.index;
+        if (nd->count == 0) {
+            deallocate_node(nd);
+            nodes.erase(nodes.begin() + n);
+            return const_iterator(&nodes, n, 0);
+        }
+        if (n + 1 < nodes.size() && nd->count + nodes[n + 1]->count <= NodeMaxSize / 2) {
+            merge_with_next(n);
+        } else if (n > 0 && nd->count + nodes[n - 1]->count <= NodeMaxSize / 2) {
+            idx += nodes[n - 1]->count;
+            merge_with_next(--n);
+        }
+        if (idx == nodes[n]->count) {
+            return const_iterator(&nodes, n + 1, 0);
+        }
+        return const_iterator(&nodes, n, idx);
+    }
+
+    // Удаляет все элементы, равные key; возвращает их число.
+    size_type erase(const T& key) {
+        size_type erased = 0;
+        for (const_iterator it = lower_bound(key); it != end() && !comp(key, *it); ++erased) {
+            it = erase(it);
+        }
+        return erased;
+    }
+
+    bool operator==(const sorted_unrolled_list& rhs) const {
+        return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const sorted_unrolled_list& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    template<typename Pred>
+    std::size_t first_node_where(Pred pred) const {
+        return std::partition_point(nodes.begin(), nodes.end(),
+                                    [&](const node_struct* nd) { return !pred(nd); }) - nodes.begin();
+    }
+
+    template<typename U>
+    const_iterator emplace_value(U&& val) {
+        if (nodes.empty()) {
+            nodes.reserve(1);
+            node_struct* nd = allocate_node();
+            try {
+                nd->construct_elem(0, std::forward<U>(val));
+            } catch (...) {
+                deallocate_node(nd);
+                throw;
+            }
+            nd->count = 1;
+            nodes.push_back(nd);
+            size_ = 1;
+            return begin();
+        }
+
+        std::size_t n = first_node_where([&](const node_struct* nd) { return comp(val, nd->last_key()); });
+        if (n == nodes.size()) --n;
+        node_struct* nd = nodes[n];
+        std::size_t idx = std::upper_bound(nd->begin(), nd->end(), val, comp) - nd->begin();
+
+        if (nd->count == NodeMaxSize) {
+            // val может ссылаться на элемент, который split перенесёт в новый узел.
+            T tmp(std::forward<U>(val));
+            split(n);
+            if (idx > nd->count) {
+                idx -= nd->count;
+                nd = nodes[++n];
+            }
+            insert_into(nd, idx, std::move(tmp));
+        } else {
+            insert_into(nd, idx, std::forward<U>(val));
+        }
+        ++size_;
+        return const_iterator(&nodes, n, idx);
+    }
+
+    template<typename U>
+    void insert_into(node_struct* nd, std::size_t idx, U&& val) {
+        if (idx == nd->count) {
+            nd->construct_elem(idx, std::forward<U>(val));
+        } else {
+            T tmp(std::forward<U>(val));
+            nd->construct_elem(nd->count, std::move(*nd->get_ptr(nd->count - 1)));
+            for (std::size_t i = nd->count - 1; i > idx; --i) {
+                *nd->get_ptr(i) = std::move(*nd->get_ptr(i - 1));
+            }
+            *nd->get_ptr(idx) = std::move(tmp);
+        }
+        ++nd->count;
+    }
+
+    // Переносит старшую половину полного узла n в новый узел сразу за ним.
+    void split(std::size_t n) {
+        nodes.reserve(nodes.size() + 1);
+        node_struct* nd = nodes[n];
+        node_struct* right = allocate_node();
+        std::size_t half = nd->count / 2;
+        std::size_t moved = 0;
+        try {
+            for (std::size_t i = half; i < nd->count; ++i) {
+                right->construct_elem(moved, std::move(*nd->get_ptr(i)));
+                right->count = ++moved;
+            }
+        } catch (...) {
+            for (std::size_t i = 0; i < right->count; ++i) {
+                right->destroy_elem(i);
+            }
+            deallocate_node(right);
+            throw;
+        }
+        for (std::size_t i = half; i < nd->count; ++i) {
+            nd->destroy_elem(i);
+        }
+        nd->count = half;
+        nodes.insert(nodes.begin() + n + 1, right);
+    }
+
+    void merge_with_next(std::size_t n) {
+        node_struct* nd = nodes[n];
+        node_struct* nx = nodes[n + 1];
+        for (std::size_t i = 0; i < nx->count; ++i) {
+            nd->construct_elem(nd->count + i, std::move(*nx->get_ptr(i)));
+            nx->destroy_elem(i);
+        }
+        nd->count += nx->count;
+        deallocate_node(nx);
+        nodes.erase(nodes.begin() + n + 1);
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct();
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
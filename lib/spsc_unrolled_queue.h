@@ -0,0 +1,231 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+
+// Очередь с одним производителем и одним потребителем на блочных узлах.
+// Производитель пишет только tail узла, потребитель только head,
+// опустошённые узлы возвращаются производителю через стек свободных узлов.
+template<typename T, std::size_t NodeMaxSize = 64, typename Allocator = std::allocator<T>>
+class spsc_unrolled_queue {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using allocator_type  = Allocator;
+
+private:
+    static constexpr std::size_t cache_line = 64;
+
+    struct node_struct {
+        std::atomic<node_struct*> next;
+        std::atomic<std::size_t>  head;
+        std::atomic<std::size_t>  tail;
+        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+        node_struct() : next(nullptr), head(0), tail(0) {}
+
+        T* get_ptr(std::size_t i) {
+            return reinterpret_cast<T*>(storage + i * sizeof(T));
+        }
+        template<typename... Args>
+        void construct_elem(std::size_t idx, Args&&... args) {
+            new (static_cast<void*>(get_ptr(idx))) T(std::forward<Args>(args)...);
+        }
+        void destroy_elem(std::size_t idx) noexcept {
+            get_ptr(idx)->~T();
+        }
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+
+    node_alloc_type node_alloc;
+    allocator_type  val_alloc;
+
+    alignas(cache_line) node_struct* tail_node;
+    alignas(cache_line) node_struct* head_node;
+    alignas(cache_line) std::atomic<node_struct*> free_nodes;
+
+public:
+    spsc_unrolled_queue()
+        : spsc_unrolled_queue(allocator_type())
+    {}
+    explicit spsc_unrolled_queue(const allocator_type& alloc)
+        : node_alloc(alloc), val_alloc(alloc), tail_node(nullptr), head_node(nullptr), free_nodes(nullptr)
+    {
+        tail_node = head_node = allocate_node();
+    }
+
+    spsc_unrolled_queue(const spsc_unrolled_queue&) = delete;
+    spsc_unrolled_queue& operator=(const spsc_unrolled_queue&) = delete;
+
+    ~spsc_unrolled_queue() {
+        node_struct* cur_node = head_node;
+        while (cur_node) {
+            node_struct* next_node = cur_node->next.load(std::memory_order_relaxed);
+            std::size_t last = cur_node->tail.load(std::memory_order_relaxed);
+            for (std::size_t i = cur_node->head.load(std::memory_order_relaxed); i < last; ++i) {
+                cur_node->destroy_elem(i);
+            }
+            deallocate_node(cur_node);
+            cur_node = next_node;
+        }
+        cur_node = free_nodes.load(std::memory_order_relaxed);
+        while (cur_node) {
+            node_struct* next_node = cur_node->next.load(std::memory_order_relaxed);
+            deallocate_node(cur_node);
+            cur_node = next_node;
+        }
+    }
+
+    allocator_type get_allocator() const {
+        return val_alloc;
+    }
+
+    // Сторона производителя.
+
+    void push(const T& val) {
+        emplace(val);
+    }
+    void push(T&& val) {
+        emplace(std::move(val));
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        node_struct* n = tail_node;
+        std::size_t t = n->tail.load(std::memory_order_relaxed);
+        if (t < NodeMaxSize) {
+            n->construct_elem(t, std::forward<Args>(args)...);
+            n->tail.store(t + 1, std::memory_order_release);
+            return;
+        }
+        node_struct* nd = acquire_node();
+        try {
+            nd->construct_elem(0, std::forward<Args>(args)...);
+        } catch (...) {
+            release_node(nd);
+            throw;
+        }
+        nd->tail.store(1, std::memory_order_relaxed);
+        n->next.store(nd, std::memory_order_release);
+        tail_node = nd;
+    }
+
+    // Публикует элементы пачкой: один release-store на узел вместо одного на элемент.
+    template<typename InputIt>
+    size_type push_n(InputIt first, size_type n) {
+        size_type pushed = 0;
+        while (pushed < n) {
+            node_struct* cur = tail_node;
+            std::size_t t = cur->tail.load(std::memory_order_relaxed);
+            if (t == NodeMaxSize) {
+                push(*first);
+                ++first;
+                ++pushed;
+                continue;
+            }
+            std::size_t last = t;
+            try {
+                for (; last < NodeMaxSize && pushed < n; ++last, ++pushed, ++first) {
+                    cur->construct_elem(last, *first);
+                }
+            } catch (...) {
+                cur->tail.store(last, std::memory_order_release);
+                throw;
+            }
+            cur->tail.store(last, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    // Сторона потребителя.
+
+    bool try_pop(T& out) {
+        node_struct* n = front_node();
+        if (!n) return false;
+        std::size_t h = n->head.load(std::memory_order_relaxed);
+        out = std::move(*n->get_ptr(h));
+        n->destroy_elem(h);
+        n->head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename OutputIt>
+    size_type try_pop_n(OutputIt out, size_type max_count) {
+        size_type popped = 0;
+        while (popped < max_count) {
+            node_struct* n = front_node();
+            if (!n) break;
+            std::size_t h = n->head.load(std::memory_order_relaxed);
+            std::size_t t = n->tail.load(std::memory_order_acquire);
+            for (; h < t && popped < max_count; ++h, ++popped) {
+                *out = std::move(*n->get_ptr(h));
+                ++out;
+                n->destroy_elem(h);
+            }
+            n->head.store(h, std::memory_order_release);
+        }
+        return popped;
+    }
+
+    bool empty() const {
+        node_struct* n = head_node;
+        std::size_t h = n->head.load(std::memory_order_relaxed);
+        if (h < n->tail.load(std::memory_order_acquire)) return false;
+        if (h < NodeMaxSize) return true;
+        node_struct* nx = n->next.load(std::memory_order_acquire);
+        return !nx || nx->tail.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    // Возвращает узел с хотя бы одним опубликованным элементом, попутно
+    // отдавая производителю полностью прочитанные узлы.
+    node_struct* front_node() {
+        node_struct* n = head_node;
+        std::size_t h = n->head.load(std::memory_order_relaxed);
+        if (h == NodeMaxSize) {
+            node_struct* nx = n->next.load(std::memory_order_acquire);
+            if (!nx) return nullptr;
+            head_node = nx;
+            release_node(n);
+            n = nx;
+            h = 0;
+        }
+        if (h == n->tail.load(std::memory_order_acquire)) return nullptr;
+        return n;
+    }
+
+    // Стек свободных узлов: кладёт любой поток, снимает только производитель,
+    // поэтому ABA при снятии невозможно.
+    void release_node(node_struct* nd) noexcept {
+        node_struct* top = free_nodes.load(std::memory_order_relaxed);
+        do {
+            nd->next.store(top, std::memory_order_relaxed);
+        } while (!free_nodes.compare_exchange_weak(top, nd, std::memory_order_release, std::memory_order_relaxed));
+    }
+    node_struct* acquire_node() {
+        node_struct* top = free_nodes.load(std::memory_order_acquire);
+        while (top && !free_nodes.compare_exchange_weak(top, top->next.load(std::memory_order_relaxed),
+                                                         std::memory_order_acquire, std::memory_order_acquire)) {
+        }
+        if (!top) return allocate_node();
+        top->next.store(nullptr, std::memory_order_relaxed);
+        top->head.store(0, std::memory_order_relaxed);
+        top->tail.store(0, std::memory_order_relaxed);
+        return top;
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct();
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
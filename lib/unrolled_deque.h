@@ -0,0 +1,489 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Блочная последовательность для нагрузки «добавление и удаление с концов».
+// Все узлы, кроме крайних, заполнены целиком, а указатели на узлы лежат
+// подряд в каталоге. Поэтому позиция элемента вычисляется делением индекса
+// на NodeMaxSize: operator[] работает за O(1), а итераторы — произвольного
+// доступа. Вставки в середину нет. Каталог держит свободные места с обеих
+// сторон и пустую ячейку сразу за последним узлом, на которую указывает
+// end(), когда последний узел заполнен.
+template<typename T, std::size_t NodeMaxSize = 64, typename Allocator = std::allocator<T>>
+class unrolled_deque {
+    static_assert(NodeMaxSize > 0, "NodeMaxSize must be positive");
+
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+private:
+    struct node_struct {
+        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+        T* get_ptr(std::size_t i) {
+            return reinterpret_cast<T*>(storage + i * sizeof(T));
+        }
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+    using dir_alloc_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct*>;
+    using directory_type  = std::vector<node_struct*, dir_alloc_type>;
+
+    node_alloc_type node_alloc;
+    allocator_type  val_alloc;
+    directory_type  dir;
+    size_type       dir_begin;
+    size_type       dir_end;
+    size_type       offset;
+    size_type       size_;
+    // Первый элемент, место за последним и конец последнего узла: операции
+    // с концов обходятся без обращения к каталогу.
+    T*              front_ptr;
+    T*              back_ptr;
+    T*              back_limit;
+
+public:
+    template<bool is_const>
+    class iterators_class {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+        using pointer           = std::conditional_t<is_const, const T*, T*>;
+        using reference         = std::conditional_t<is_const, const T&, T&>;
+
+        iterators_class() = default;
+
+        template<bool B, typename = std::enable_if_t<!B && is_const>>
+        iterators_class(const iterators_class<B>& other)
+            : node(other.node), cur(other.cur), first(other.first)
+        {}
+
+        reference operator*() const {
+            return *cur;
+        }
+        pointer operator->() const {
+            return cur;
+        }
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        iterators_class& operator++() {
+            if (++cur == first + NodeMaxSize) {
+                set_node(node + 1);
+                cur = first;
+            }
+            return *this;
+        }
+        iterators_class operator++(int) {
+            iterators_class tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+        iterators_class& operator--() {
+            if (cur == first) {
+                set_node(node - 1);
+                cur = first + NodeMaxSize;
+            }
+            --cur;
+            return *this;
+        }
+        iterators_class operator--(int) {
+            iterators_class tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        iterators_class& operator+=(difference_type n) {
+            constexpr difference_type width = static_cast<difference_type>(NodeMaxSize);
+            difference_type pos = (cur - first) + n;
+            if (pos >= 0 && pos < width) {
+                cur += n;
+            } else {
+                difference_type hop = pos >= 0 ? pos / width : -((-pos - 1) / width) - 1;
+                set_node(node + hop);
+                cur = first + (pos - hop * width);
+            }
+            return *this;
+        }
+        iterators_class& operator-=(difference_type n) {
+            return *this += -n;
+        }
+        friend iterators_class operator+(iterators_class it, difference_type n) {
+            return it += n;
+        }
+        friend iterators_class operator+(difference_type n, iterators_class it) {
+            return it += n;
+        }
+        friend iterators_class operator-(iterators_class it, difference_type n) {
+            return it -= n;
+        }
+        friend difference_type operator-(const iterators_class& a, const iterators_class& b) {
+            return (a.node - b.node) * static_cast<difference_type>(NodeMaxSize)
+                   + (a.cur - a.first) - (b.cur - b.first);
+        }
+
+        bool operator==(const iterators_class& other) const {
+            return node == other.node && cur == other.cur;
+        }
+        auto operator<=>(const iterators_class& other) const {
+            return (*this - other) <=> 0;
+        }
+
+    private:
+        friend class unrolled_deque;
+        template<bool> friend class iterators_class;
+
+        using value_pointer = std::conditional_t<is_const, const T*, T*>;
+
+        node_struct* const* node  = nullptr;
+        value_pointer       cur   = nullptr;
+        value_pointer       first = nullptr;
+
+        iterators_class(node_struct* const* n, std::size_t i) {
+            set_node(n);
+            cur = first + i;
+        }
+
+        // За последним узлом в каталоге стоит nullptr: на нём first == nullptr,
+        // и cur - first == 0 для итератора end().
+        void set_node(node_struct* const* n) {
+            node = n;
+            first = *n ? (*n)->get_ptr(0) : nullptr;
+        }
+    };
+
+    using iterator               = iterators_class<false>;
+    using const_iterator         = iterators_class<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    unrolled_deque()
+        : unrolled_deque(Allocator())
+    {}
+    explicit unrolled_deque(const Allocator& alloc)
+        : node_alloc(alloc), val_alloc(alloc), dir(1, nullptr, dir_alloc_type(alloc)),
+          dir_begin(0), dir_end(0), offset(0), size_(0),
+          front_ptr(nullptr), back_ptr(nullptr), back_limit(nullptr)
+    {}
+    unrolled_deque(std::initializer_list<T> il, const Allocator& alloc = Allocator())
+        : unrolled_deque(alloc)
+    {
+        for (const T& val : il) {
+            push_back(val);
+        }
+    }
+    template<typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    unrolled_deque(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : unrolled_deque(alloc)
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+    unrolled_deque(const unrolled_deque& other)
+        : unrolled_deque(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.val_alloc))
+    {
+        for (const T& val : other) {
+            push_back(val);
+        }
+    }
+    unrolled_deque(unrolled_deque&& other)
+        : unrolled_deque(other.val_alloc)
+    {
+        swap(other);
+    }
+    unrolled_deque& operator=(const unrolled_deque& other) {
+        if (this != &other) {
+            unrolled_deque tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    unrolled_deque& operator=(unrolled_deque&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+    ~unrolled_deque() {
+        clear();
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return val_alloc;
+    }
+
+    void swap(unrolled_deque& other) noexcept {
+        using std::swap;
+        swap(node_alloc, other.node_alloc);
+        swap(val_alloc,  other.val_alloc);
+        swap(dir,        other.dir);
+        swap(dir_begin,  other.dir_begin);
+        swap(dir_end,    other.dir_end);
+        swap(offset,     other.offset);
+        swap(size_,      other.size_);
+        swap(front_ptr,  other.front_ptr);
+        swap(back_ptr,   other.back_ptr);
+        swap(back_limit, other.back_limit);
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+    size_type node_count() const noexcept {
+        return dir_end - dir_begin;
+    }
+
+    iterator begin() noexcept {
+        return iterator(dir.data() + dir_begin, offset);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(dir.data() + dir_begin, offset);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    iterator end() noexcept {
+        size_type pos = offset + size_;
+        return iterator(dir.data() + dir_begin + pos / NodeMaxSize, pos % NodeMaxSize);
+    }
+    const_iterator end() const noexcept {
+        size_type pos = offset + size_;
+        return const_iterator(dir.data() + dir_begin + pos / NodeMaxSize, pos % NodeMaxSize);
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    T& operator[](size_type i) noexcept {
+        return *element(i);
+    }
+    const T& operator[](size_type i) const noexcept {
+        return *element(i);
+    }
+    T& at(size_type i) {
+        if (i >= size_) {
+            throw std::out_of_range("unrolled_deque::at");
+        }
+        return *element(i);
+    }
+    const T& at(size_type i) const {
+        if (i >= size_) {
+            throw std::out_of_range("unrolled_deque::at");
+        }
+        return *element(i);
+    }
+    T& front() noexcept {
+        return *front_ptr;
+    }
+    const T& front() const noexcept {
+        return *front_ptr;
+    }
+    T& back() noexcept {
+        return *(back_ptr - 1);
+    }
+    const T& back() const noexcept {
+        return *(back_ptr - 1);
+    }
+
+    void push_back(const T& val) {
+        emplace_back(val);
+    }
+    void push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        bool grown = back_ptr == back_limit;
+        if (grown) {
+            grow_back();
+        }
+        try {
+            new (static_cast<void*>(back_ptr)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            if (grown) {
+                drop_back_node();
+            }
+            throw;
+        }
+        ++size_;
+        return *(back_ptr++);
+    }
+
+    void push_front(const T& val) {
+        emplace_front(val);
+    }
+    void push_front(T&& val) {
+        emplace_front(std::move(val));
+    }
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        bool grown = offset == 0;
+        if (grown) {
+            grow_front();
+        }
+        T* slot = dir[dir_begin]->get_ptr(offset - 1);
+        try {
+            new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            if (grown) {
+                drop_front_node();
+            }
+            throw;
+        }
+        if (size_++ == 0) {
+            back_ptr = slot + 1;
+            back_limit = dir[dir_begin]->get_ptr(NodeMaxSize);
+        }
+        --offset;
+        front_ptr = slot;
+        return *slot;
+    }
+
+    void pop_back() noexcept {
+        if (size_ == 0) return;
+        (--back_ptr)->~T();
+        if (--size_ == 0) {
+            release_all();
+        } else if (back_ptr == dir[dir_end - 1]->get_ptr(0)) {
+            drop_back_node();
+        }
+    }
+    void pop_front() noexcept {
+        if (size_ == 0) return;
+        (front_ptr++)->~T();
+        if (--size_ == 0) {
+            release_all();
+        } else if (++offset == NodeMaxSize) {
+            drop_front_node();
+        }
+    }
+
+    void clear() noexcept {
+        for (size_type i = 0; i < size_; ++i) {
+            element(i)->~T();
+        }
+        size_ = 0;
+        release_all();
+    }
+
+    bool operator==(const unrolled_deque& rhs) const {
+        return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+    }
+
+private:
+    T* element(size_type i) const noexcept {
+        size_type pos = offset + i;
+        return dir[dir_begin + pos / NodeMaxSize]->get_ptr(pos % NodeMaxSize);
+    }
+
+    void grow_back() {
+        if (dir_end + 1 >= dir.size()) {
+            recenter();
+        }
+        node_struct* nd = allocate_node();
+        dir[dir_end++] = nd;
+        back_ptr = nd->get_ptr(0);
+        back_limit = nd->get_ptr(NodeMaxSize);
+        if (size_ == 0) {
+            front_ptr = back_ptr;
+        }
+    }
+    void grow_front() {
+        if (dir_begin == 0) {
+            recenter();
+        }
+        dir[dir_begin - 1] = allocate_node();
+        --dir_begin;
+        offset += NodeMaxSize;
+    }
+
+    // Освобождают опустевший крайний узел. Список при этом не пуст,
+    // кроме случая отката неудачной вставки в пустой контейнер.
+    void drop_back_node() noexcept {
+        deallocate_node(dir[--dir_end]);
+        dir[dir_end] = nullptr;
+        if (dir_end == dir_begin) {
+            release_all();
+            return;
+        }
+        back_limit = dir[dir_end - 1]->get_ptr(NodeMaxSize);
+        back_ptr = back_limit;
+    }
+    void drop_front_node() noexcept {
+        deallocate_node(dir[dir_begin]);
+        dir[dir_begin++] = nullptr;
+        offset = 0;
+        if (dir_end == dir_begin) {
+            release_all();
+            return;
+        }
+        front_ptr = dir[dir_begin]->get_ptr(0);
+    }
+
+    // Переносит узлы в середину каталога, при необходимости увеличив его,
+    // так что с обеих сторон остаются свободные ячейки.
+    void recenter() {
+        size_type used = node_count();
+        size_type new_size = std::max<size_type>(dir.size(), std::max<size_type>(8, 2 * used + 4));
+        directory_type fresh(new_size, nullptr, dir.get_allocator());
+        size_type start = (new_size - used) / 2;
+        std::copy(dir.begin() + static_cast<difference_type>(dir_begin),
+                  dir.begin() + static_cast<difference_type>(dir_end),
+                  fresh.begin() + static_cast<difference_type>(start));
+        dir.swap(fresh);
+        dir_begin = start;
+        dir_end = start + used;
+    }
+
+    void release_all() noexcept {
+        for (size_type k = dir_begin; k < dir_end; ++k) {
+            deallocate_node(dir[k]);
+            dir[k] = nullptr;
+        }
+        dir_begin = dir_end = dir.size() / 2;
+        offset = 0;
+        front_ptr = back_ptr = back_limit = nullptr;
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct;
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
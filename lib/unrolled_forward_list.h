@@ -0,0 +1,460 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "unrolled_node.h"
+
+// Односвязный блочный список для нагрузки «дописать и пройти вперёд».
+// Узел хранит только next и счётчик, так что заголовок на указатель короче,
+// чем у unrolled_list. Интерфейс повторяет std::forward_list: вставка
+// и удаление — insert_after/erase_after, before_begin() указывает перед
+// первым элементом. Хвост хранится отдельно, поэтому push_back — O(1).
+template<typename T, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+class unrolled_forward_list {
+    static_assert(NodeMaxSize > 0, "NodeMaxSize must be positive");
+
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+private:
+    using count_type = unrolled_list_count_t<NodeMaxSize>;
+
+    struct node_struct : unrolled_node_storage<T, NodeMaxSize> {
+        node_struct* next  = nullptr;
+        count_type   count = 0;
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+
+    // Позиция before_begin(): index на единицу меньше нуля, так что ++
+    // переводит её в (head, 0), то есть в begin().
+    static constexpr std::size_t before_index = std::numeric_limits<std::size_t>::max();
+
+    node_alloc_type node_alloc;
+    allocator_type  val_alloc;
+    node_struct*    head;
+    node_struct*    tail;
+    size_type       size_;
+
+public:
+    template<bool is_const>
+    class iterators_class {
+    public:
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+        using pointer           = std::conditional_t<is_const, const T*, T*>;
+        using reference         = std::conditional_t<is_const, const T&, T&>;
+
+        iterators_class(node_struct* n = nullptr, std::size_t i = 0) noexcept
+            : node_ptr(n), index(i)
+        {}
+
+        template<bool B, typename = std::enable_if_t<!B && is_const>>
+        iterators_class(const iterators_class<B>& other) noexcept
+            : node_ptr(other.node_ptr), index(other.index)
+        {}
+
+        reference operator*() const noexcept {
+            return *(node_ptr->get_ptr(index));
+        }
+        pointer operator->() const noexcept {
+            return node_ptr->get_ptr(index);
+        }
+
+        iterators_class& operator++() noexcept {
+            if (!node_ptr) [[unlikely]] {
+                // before_begin() пустого списка
+                index = 0;
+                return *this;
+            }
+            if (++index == node_ptr->count) {
+                node_ptr = node_ptr->next;
+                index = 0;
+            }
+            return *this;
+        }
+        iterators_class operator++(int) noexcept {
+            iterators_class tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterators_class& other) const noexcept {
+            return node_ptr == other.node_ptr && index == other.index;
+        }
+        bool operator!=(const iterators_class& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        friend class unrolled_forward_list;
+        template<bool> friend class iterators_class;
+
+        node_struct* node_ptr;
+        std::size_t  index;
+    };
+
+    using iterator       = iterators_class<false>;
+    using const_iterator = iterators_class<true>;
+
+    unrolled_forward_list()
+        : node_alloc(), val_alloc(), head(nullptr), tail(nullptr), size_(0)
+    {}
+    explicit unrolled_forward_list(const allocator_type& alloc)
+        : node_alloc(alloc), val_alloc(alloc), head(nullptr), tail(nullptr), size_(0)
+    {}
+    template<std::input_iterator InputIt>
+    unrolled_forward_list(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+        : unrolled_forward_list(alloc)
+    {
+        try {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    unrolled_forward_list(std::initializer_list<T> il, const allocator_type& alloc = allocator_type())
+        : unrolled_forward_list(il.begin(), il.end(), alloc)
+    {}
+    unrolled_forward_list(const unrolled_forward_list& other)
+        : unrolled_forward_list(other.begin(), other.end(),
+              std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.val_alloc))
+    {}
+    unrolled_forward_list(unrolled_forward_list&& other) noexcept
+        : node_alloc(std::move(other.node_alloc)), val_alloc(std::move(other.val_alloc)),
+          head(other.head), tail(other.tail), size_(other.size_)
+    {
+        other.head = other.tail = nullptr;
+        other.size_ = 0;
+    }
+    ~unrolled_forward_list() {
+        clear();
+    }
+
+    unrolled_forward_list& operator=(const unrolled_forward_list& other) {
+        if (this != &other) {
+            unrolled_forward_list tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    unrolled_forward_list& operator=(unrolled_forward_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void swap(unrolled_forward_list& other) noexcept {
+        using std::swap;
+        swap(node_alloc, other.node_alloc);
+        swap(val_alloc,  other.val_alloc);
+        swap(head,       other.head);
+        swap(tail,       other.tail);
+        swap(size_,      other.size_);
+    }
+
+    allocator_type get_allocator() const {
+        return val_alloc;
+    }
+
+    bool operator==(const unrolled_forward_list& rhs) const {
+        return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const unrolled_forward_list& rhs) const {
+        return !(*this == rhs);
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    iterator before_begin() noexcept {
+        return iterator(head, before_index);
+    }
+    const_iterator before_begin() const noexcept {
+        return const_iterator(head, before_index);
+    }
+    const_iterator cbefore_begin() const noexcept {
+        return before_begin();
+    }
+    iterator begin() noexcept {
+        return iterator(head, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(head, 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    iterator end() noexcept {
+        return iterator(nullptr, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr, 0);
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    T& front() {
+        return *(head->get_ptr(0));
+    }
+    const T& front() const {
+        return *(head->get_ptr(0));
+    }
+    T& back() {
+        return *(tail->get_ptr(tail->count - 1));
+    }
+    const T& back() const {
+        return *(tail->get_ptr(tail->count - 1));
+    }
+
+    void push_back(const T& val) {
+        emplace_back(val);
+    }
+    void push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (!tail || tail->count == NodeMaxSize) {
+            node_struct* nd = allocate_node();
+            try {
+                new (static_cast<void*>(nd->get_ptr(0))) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_node(nd);
+                throw;
+            }
+            nd->count = 1;
+            if (tail) {
+                tail->next = nd;
+            } else {
+                head = nd;
+            }
+            tail = nd;
+        } else {
+            new (static_cast<void*>(tail->get_ptr(tail->count))) T(std::forward<Args>(args)...);
+            ++tail->count;
+        }
+        ++size_;
+        return back();
+    }
+
+    void push_front(const T& val) {
+        insert_after(before_begin(), val);
+    }
+    void push_front(T&& val) {
+        insert_after(before_begin(), std::move(val));
+    }
+    void pop_front() noexcept {
+        if (head) {
+            erase_at(nullptr, head, 0);
+        }
+    }
+
+    // Вставляет после pos и возвращает итератор на вставленный элемент.
+    iterator insert_after(const_iterator pos, const T& val) {
+        return do_insert_after(pos, val);
+    }
+    iterator insert_after(const_iterator pos, T&& val) {
+        return do_insert_after(pos, std::move(val));
+    }
+    // Удаляет элемент после pos и возвращает итератор на следующий за ним.
+    iterator erase_after(const_iterator pos) noexcept {
+        if (pos.index == before_index) {
+            return erase_at(nullptr, head, 0);
+        }
+        node_struct* n = pos.node_ptr;
+        if (pos.index + 1 < n->count) {
+            return erase_at(nullptr, n, pos.index + 1);
+        }
+        return erase_at(n, n->next, 0);
+    }
+    // Удаляет элементы в (first, last).
+    iterator erase_after(const_iterator first, const_iterator last) noexcept {
+        iterator res(last.node_ptr, last.index);
+        for (auto n = std::distance(first, last) - 1; n > 0; --n) {
+            res = erase_after(first);
+        }
+        return res;
+    }
+
+    void clear() noexcept {
+        while (head) {
+            node_struct* next = head->next;
+            for (std::size_t i = 0; i < head->count; ++i) {
+                head->destroy_elem(i);
+            }
+            deallocate_node(head);
+            head = next;
+        }
+        tail = nullptr;
+        size_ = 0;
+    }
+
+    size_type node_count() const noexcept {
+        size_type nodes = 0;
+        for (const node_struct* n = head; n; n = n->next) {
+            ++nodes;
+        }
+        return nodes;
+    }
+    // Байты, занятые узлами.
+    size_type bytes_allocated() const noexcept {
+        return node_count() * sizeof(node_struct);
+    }
+
+private:
+    // Вставка на позицию idx узла n. Вставка за конец полного узла
+    // открывает новый узел, в середину полного — делит его пополам.
+    template<typename U>
+    iterator do_insert_after(const_iterator pos, U&& val) {
+        node_struct* n;
+        std::size_t idx;
+        if (pos.index == before_index) {
+            n = head;
+            idx = 0;
+        } else {
+            n = pos.node_ptr;
+            idx = pos.index + 1;
+        }
+        if (!n) {
+            emplace_back(std::forward<U>(val));
+            return iterator(tail, 0);
+        }
+        if (n->count == NodeMaxSize) {
+            if (idx == NodeMaxSize) {
+                node_struct* nd = allocate_node();
+                try {
+                    nd->construct_elem(0, std::forward<U>(val));
+                } catch (...) {
+                    deallocate_node(nd);
+                    throw;
+                }
+                nd->count = 1;
+                link_after(n, nd);
+                ++size_;
+                return iterator(nd, 0);
+            }
+            if (idx == 0 && n == head) {
+                node_struct* nd = allocate_node();
+                try {
+                    nd->construct_elem(0, std::forward<U>(val));
+                } catch (...) {
+                    deallocate_node(nd);
+                    throw;
+                }
+                nd->count = 1;
+                nd->next = head;
+                head = nd;
+                ++size_;
+                return iterator(nd, 0);
+            }
+            T tmp(std::forward<U>(val));
+            split_node(n);
+            if (idx > n->count) {
+                idx -= n->count;
+                n = n->next;
+            }
+            return place(n, idx, std::move(tmp));
+        }
+        return place(n, idx, std::forward<U>(val));
+    }
+
+    template<typename U>
+    iterator place(node_struct* n, std::size_t idx, U&& val) {
+        if (idx == n->count) {
+            n->construct_elem(idx, std::forward<U>(val));
+        } else {
+            T tmp(std::forward<U>(val));
+            n->construct_elem(n->count, std::move(*(n->get_ptr(n->count - 1))));
+            for (std::size_t i = n->count - 1; i > idx; --i) {
+                *(n->get_ptr(i)) = std::move(*(n->get_ptr(i - 1)));
+            }
+            *(n->get_ptr(idx)) = std::move(tmp);
+        }
+        ++n->count;
+        ++size_;
+        return iterator(n, idx);
+    }
+
+    // Удаляет элемент idx узла n; before — узел перед n. before == nullptr
+    // только если n == head или если n не может опустеть: erase_after
+    // передаёт idx = pos.index + 1 < count, и в узле остаётся элемент pos.
+    iterator erase_at(node_struct* before, node_struct* n, std::size_t idx) noexcept {
+        for (std::size_t i = idx; i + 1 < n->count; ++i) {
+            *(n->get_ptr(i)) = std::move(*(n->get_ptr(i + 1)));
+        }
+        n->destroy_elem(n->count - 1);
+        --n->count;
+        --size_;
+        node_struct* next = n->next;
+        if (n->count == 0) {
+            if (before) {
+                before->next = next;
+            } else {
+                head = next;
+            }
+            if (n == tail) {
+                tail = before;
+            }
+            deallocate_node(n);
+            return iterator(next, 0);
+        }
+        if (idx == n->count) {
+            return iterator(next, 0);
+        }
+        return iterator(n, idx);
+    }
+
+    void link_after(node_struct* n, node_struct* nd) noexcept {
+        nd->next = n->next;
+        n->next = nd;
+        if (n == tail) {
+            tail = nd;
+        }
+    }
+
+    // Переносит старшую половину полного узла в новый узел сразу за ним.
+    void split_node(node_struct* n) {
+        node_struct* nd = allocate_node();
+        std::size_t half = n->count / 2;
+        for (std::size_t i = half; i < n->count; ++i) {
+            nd->construct_elem(i - half, std::move(*(n->get_ptr(i))));
+            n->destroy_elem(i);
+        }
+        nd->count = static_cast<count_type>(n->count - half);
+        n->count = static_cast<count_type>(half);
+        link_after(n, nd);
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct;
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
@@ -1,16 +1,114 @@
 #pragma once
 
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <algorithm>
 #include <limits>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "unrolled_node.h"
+
+#if __has_include(<sys/uio.h>)
+#include <cerrno>
+#include <climits>
+#include <system_error>
+#include <sys/uio.h>
+#include <unistd.h>
+#define UNROLLED_LIST_HAS_POSIX_IO 1
+#endif
 
 struct Node_Tag {};
 
-template<typename T, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+struct no_node_summary {
+    template<typename T>
+    void add(const T&) noexcept {}
+    void reset() noexcept {}
+};
+
+// События, о которых контейнер сообщает хукам. Для каждого события вызывается
+// enter(event) до работы и leave(event, amount) после неё; amount — число
+// узлов или перемещённых элементов.
+enum class unrolled_list_event {
+    node_allocate,
+    node_free,
+    shift,
+    split,
+    clear,
+};
+
+inline constexpr std::size_t unrolled_list_event_count = 5;
+
+struct no_hooks {
+    void enter(unrolled_list_event) noexcept {}
+    void leave(unrolled_list_event, std::size_t) noexcept {}
+};
+
+// Набор политик контейнера. Свою политику удобно наследовать от этой
+// и переопределять только нужные члены.
+struct unrolled_list_policy {
+    using summary = no_node_summary;
+    // Готовые хуки — counting_hooks и timing_hooks из list_hooks.h.
+    using hooks = no_hooks;
+    // Накопительные счётчики операций для stats(); выключенные ничего не стоят.
+    static constexpr bool count_operations = false;
+    // На сколько узлов вперёд итераторы и scan() подгружают узлы в кэш
+    // при переходе в следующий узел: 0 — не подгружать, 1 — следующий,
+    // 2 — следующий и через один.
+    static constexpr std::size_t prefetch_distance = 1;
+    // Хранить в заголовке узла prev ^ next одним словом вместо двух
+    // указателей. Соседа узла тогда находят по другому соседу, поэтому
+    // итераторы дополнительно помнят предыдущий узел. Отсюда более строгое
+    // правило: итераторы узла становятся недействительными и тогда, когда
+    // перед узлом появляется или исчезает узел — разбиение предыдущего
+    // узла, удаление опустевшего предыдущего узла, push_front или
+    // pop_front, сменившие первый узел, — хотя элементы узла не двигались.
+    static constexpr bool xor_links = false;
+    // Не возвращать освобождённые узлы аллокатору, а держать их в пуле
+    // списка для следующих выделений. clear() тогда отдаёт пулу всю цепочку
+    // разом; память возвращает release_node_pool() или деструктор.
+    // Хуки node_allocate/node_free и счётчики allocations/frees отражают
+    // только обращения к аллокатору: взятие узла из пула и возврат в пул
+    // их не вызывают.
+    static constexpr bool node_pool = false;
+};
+
+struct unrolled_list_counters {
+    std::size_t allocations = 0;
+    std::size_t frees       = 0;
+    std::size_t shifts      = 0;
+    std::size_t splits      = 0;
+
+    unrolled_list_counters& operator+=(const unrolled_list_counters& other) noexcept {
+        allocations += other.allocations;
+        frees       += other.frees;
+        shifts      += other.shifts;
+        splits      += other.splits;
+        return *this;
+    }
+};
+
+// Точка настройки сериализации для типов, которые нельзя писать побайтово:
+//
+//     template<> struct unrolled_list_serializer<Foo> {
+//         template<typename Out> static void write(Out& out, const Foo& val);
+//         template<typename In>  static Foo read(In& in);
+//     };
+//
+// Out и In ведут себя как std::ostream/std::istream: write(const char*, n),
+// read(char*, n) и проверка состояния через operator bool.
+template<typename T>
+struct unrolled_list_serializer {};
+
+template<typename T, std::size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>, typename Policy = unrolled_list_policy>
 class unrolled_list {
 public:
     using value_type        = T;                
@@ -19,40 +117,125 @@ public:
     using size_type         = std::size_t;      
     using difference_type   = std::ptrdiff_t;   
     using allocator_type    = Allocator;        
+    using summary_type      = typename Policy::summary;
+    using hooks_type        = typename Policy::hooks;
+
+    struct scan_stats {
+        size_type nodes_scanned = 0;
+        size_type nodes_skipped = 0;
+        size_type matches       = 0;
+    };
+
+    // Снимок заполненности узлов. fill_histogram[k] — число узлов с k элементами.
+    struct list_stats {
+        size_type              nodes           = 0;
+        size_type              elements        = 0;
+        size_type              min_fill        = 0;
+        size_type              max_fill        = 0;
+        double                 avg_fill        = 0;
+        std::vector<size_type> fill_histogram  = std::vector<size_type>(NodeMaxSize + 1);
+        size_type              bytes_allocated = 0;
+        size_type              bytes_used      = 0;
+        unrolled_list_counters counters;
+    };
+
+    struct append_result {
+        size_type elements       = 0;
+        size_type trailing_bytes = 0;
+    };
 
 private:
-    struct node_struct {
-        node_struct* prev;
-        node_struct* next;
-        std::size_t count;
-        alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+    static constexpr bool has_summary = !std::is_same_v<summary_type, no_node_summary>;
+    static constexpr bool has_counters = Policy::count_operations;
+    static constexpr bool has_pool = Policy::node_pool;
 
-        node_struct() : prev(nullptr), next(nullptr), count(0) {}
+    struct no_counters {};
+    struct no_pool {};
 
-        T* get_ptr(std::size_t i) {
-            return reinterpret_cast<T*>(storage + i * sizeof(T));
-        }
-        const T* get_ptr(std::size_t i) const {
-            return reinterpret_cast<const T*>(storage + i * sizeof(T));
-        }
-        void construct_elem(std::size_t idx, const T& val) {
-            new (static_cast<void*>(get_ptr(idx))) T(val);
+    static constexpr bool xor_links = Policy::xor_links;
+    using count_type = unrolled_list_count_t<NodeMaxSize>;
+
+    struct node_struct;
+    struct pair_links {
+        node_struct* prev = nullptr;
+        node_struct* next = nullptr;
+    };
+    struct xor_link {
+        std::uintptr_t link = 0;
+    };
+    struct no_prev_node {};
+    using prev_node_type = std::conditional_t<xor_links, node_struct*, no_prev_node>;
+
+    struct node_struct : std::conditional_t<xor_links, xor_link, pair_links>, unrolled_node_storage<T, NodeMaxSize> {
+        count_type count;
+        [[no_unique_address]] summary_type summary;
+
+        node_struct() : count(0), summary() {}
+    };
+
+    // Переходы по ссылкам узла. В режиме xor_links сосед вычисляется
+    // по известному соседу с другой стороны; set_links перезаписывает обе.
+    static node_struct* next_of(const node_struct* n, const node_struct* prev) noexcept {
+        if constexpr (xor_links) {
+            return reinterpret_cast<node_struct*>(n->link ^ reinterpret_cast<std::uintptr_t>(prev));
+        } else {
+            return n->next;
         }
-        void construct_elem(std::size_t idx, T&& val) {
-            new (static_cast<void*>(get_ptr(idx))) T(std::move(val));
+    }
+    static node_struct* prev_of(const node_struct* n, const node_struct* next) noexcept {
+        if constexpr (xor_links) {
+            return reinterpret_cast<node_struct*>(n->link ^ reinterpret_cast<std::uintptr_t>(next));
+        } else {
+            return n->prev;
         }
-        void destroy_elem(std::size_t idx) noexcept {
-            get_ptr(idx)->~T();
+    }
+    static void set_links(node_struct* n, node_struct* prev, node_struct* next) noexcept {
+        if constexpr (xor_links) {
+            n->link = reinterpret_cast<std::uintptr_t>(prev) ^ reinterpret_cast<std::uintptr_t>(next);
+        } else {
+            n->prev = prev;
+            n->next = next;
         }
-    };
+    }
 
-    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<Node_Tag>;
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
 
     node_alloc_type node_alloc;
     allocator_type  val_alloc;
     node_struct*    head;
     node_struct*    tail;
     size_type       size_;
+    [[no_unique_address]] std::conditional_t<has_counters, unrolled_list_counters, no_counters> counters_{};
+    [[no_unique_address]] hooks_type hooks_{};
+    // Свободные узлы; связаны так же, как узлы списка, первый без prev.
+    [[no_unique_address]] std::conditional_t<has_pool, node_struct*, no_pool> pool_{};
+
+    // Узел последнего позиционного обращения, узел перед ним и номер его
+    // первого элемента. Сбрасывается любым изменением, сдвигающим номера.
+    struct finger_type {
+        node_struct* node   = nullptr;
+        node_struct* before = nullptr;
+        size_type    start  = 0;
+    };
+    finger_type finger_{};
+
+    // Вызывает enter при создании и leave при разрушении.
+    struct hook_scope {
+        hooks_type&         hooks;
+        unrolled_list_event event;
+        std::size_t         amount;
+
+        hook_scope(hooks_type& h, unrolled_list_event e, std::size_t n) noexcept
+            : hooks(h), event(e), amount(n)
+        {
+            hooks.enter(event);
+        }
+        ~hook_scope() {
+            hooks.leave(event, amount);
+        }
+        hook_scope(const hook_scope&) = delete;
+        hook_scope& operator=(const hook_scope&) = delete;
+    };
 
 public:
     template<bool is_const>
@@ -64,38 +247,54 @@ public:
         using pointer           = std::conditional_t<is_const, const T*, T*>;
         using reference         = std::conditional_t<is_const, const T&, T&>;
 
+        // cur указывает на текущий элемент, поэтому ++ — это сдвиг указателя
+        // и сравнение с концом заполненной части узла. Конец берётся по
+        // текущему count: узел мог вырасти или уменьшиться после создания
+        // итератора. У end() оба поля нулевые. prev_node — узел перед
+        // node_ptr, хранится только в режиме xor_links и устаревает, когда
+        // перед node_ptr вставлен или удалён узел (см. Policy::xor_links).
         node_struct* node_ptr;
-        std::size_t  index;
+        T*           cur;
+        [[no_unique_address]] prev_node_type prev_node{};
 
-        iterators_class(node_struct* n = nullptr, std::size_t i = 0)
-            : node_ptr(n), index(i)
-        {}
+        iterators_class(node_struct* n = nullptr, std::size_t i = 0, node_struct* before = nullptr)
+            : node_ptr(n),
+              cur(n ? n->get_ptr(i) : nullptr)
+        {
+            if constexpr (xor_links) {
+                prev_node = before;
+            }
+        }
 
         template<bool B, typename = std::enable_if_t<!B && is_const>>
         iterators_class(const iterators_class<B>& other)
-            : node_ptr(other.node_ptr), index(other.index)
+            : node_ptr(other.node_ptr), cur(other.cur), prev_node(other.prev_node)
         {}
 
+        // Узел перед текущим в обоих режимах ссылок.
+        node_struct* node_before() const noexcept {
+            if constexpr (xor_links) {
+                return prev_node;
+            } else {
+                return node_ptr ? node_ptr->prev : nullptr;
+            }
+        }
+
+        // У end() номер 0, как у cur == nullptr в конструкторе.
+        std::size_t index() const noexcept {
+            return node_ptr ? static_cast<std::size_t>(cur - node_ptr->get_ptr(0)) : 0;
+        }
+
         reference operator*() const {
-            return *(node_ptr->get_ptr(index));
+            return *cur;
         }
         pointer operator->() const {
-            return node_ptr->get_ptr(index);
+            return cur;
         }
 
         iterators_class& operator++() {
-            if (node_ptr) {
-                if (index + 1 < node_ptr->count) {
-                    ++index;
-                } else {
-                    if (node_ptr->next) {
-                        node_ptr = node_ptr->next;
-                        index = 0;
-                    } else {
-                        node_ptr = nullptr;
-                        index = 0;
-                    }
-                }
+            if (node_ptr && ++cur >= node_ptr->get_ptr(node_ptr->count)) {
+                next_segment();
             }
             return *this;
         }
@@ -106,16 +305,17 @@ public:
         }
         iterators_class& operator--() {
             if (node_ptr) {
-                if (index > 0) {
-                    --index;
-                } else {
-                    if (node_ptr->prev) {
-                        node_ptr = node_ptr->prev;
-                        index = node_ptr->count - 1;
-                    } else {
-                        node_ptr = nullptr;
-                        index = 0;
+                if (cur != node_ptr->get_ptr(0)) {
+                    --cur;
+                } else if (node_struct* before = node_before()) {
+                    if constexpr (xor_links) {
+                        prev_node = prev_of(before, node_ptr);
                     }
+                    node_ptr = before;
+                    cur = node_ptr->get_ptr(node_ptr->count - 1);
+                } else {
+                    node_ptr = nullptr;
+                    cur = nullptr;
                 }
             }
             return *this;
@@ -127,11 +327,26 @@ public:
         }
 
         bool operator==(const iterators_class& other) const {
-            return (node_ptr == other.node_ptr) && (index == other.index);
+            return cur == other.cur;
         }
         bool operator!=(const iterators_class& other) const {
             return !(*this == other);
         }
+
+    private:
+        void next_segment() noexcept {
+            node_struct* before = node_ptr;
+            node_ptr = next_of(node_ptr, node_before());
+            if constexpr (xor_links) {
+                prev_node = before;
+            }
+            if (node_ptr) {
+                cur = node_ptr->get_ptr(0);
+                prefetch_ahead(node_ptr, before);
+            } else {
+                cur = nullptr;
+            }
+        }
     };
 
     using iterator       = iterators_class<false>;
@@ -317,15 +532,21 @@ public:
           val_alloc(std::move(other.val_alloc)),
           head(other.head),
           tail(other.tail),
-          size_(other.size_)
+          size_(other.size_),
+          counters_(std::move(other.counters_)),
+          hooks_(std::move(other.hooks_)),
+          pool_(std::exchange(other.pool_, {}))
     {
         other.head = nullptr;
         other.tail = nullptr;
         other.size_ = 0;
+        other.counters_ = {};
+        other.drop_finger();
     }
 
     ~unrolled_list() {
         clear();
+        release_node_pool();
     }
 
     unrolled_list& operator=(const unrolled_list& other) {
@@ -345,14 +566,19 @@ public:
     unrolled_list& operator=(unrolled_list&& other) noexcept {
         if (this != &other) {
             clear();
+            release_node_pool();
             node_alloc = std::move(other.node_alloc);
             val_alloc  = std::move(other.val_alloc);
             head       = other.head;
             tail       = other.tail;
             size_      = other.size_;
+            counters_  = std::move(other.counters_);
+            hooks_     = std::move(other.hooks_);
             other.head = nullptr;
             other.tail = nullptr;
             other.size_ = 0;
+            other.counters_ = {};
+            other.drop_finger();
         }
         return *this;
     }
@@ -406,21 +632,89 @@ public:
         swap(head,       other.head);
         swap(tail,       other.tail);
         swap(size_,      other.size_);
+        swap(pool_,      other.pool_);
+        swap(counters_,  other.counters_);
+        swap(hooks_,     other.hooks_);
+        drop_finger();
+        other.drop_finger();
     }
 
+    // Переносит все узлы other в конец списка перевязкой указателей, за O(1).
+    // Последний узел this остаётся неполным, если был неполным. При неравных
+    // аллокаторах элементы перемещаются по одному.
+    void splice_back(unrolled_list&& other) {
+        if (this == &other || !other.head) return;
+        if (node_alloc != other.node_alloc) {
+            for (auto& el : other) {
+                push_back(std::move(el));
+            }
+            other.clear();
+            return;
+        }
+        if (tail) {
+            set_links(tail, prev_of(tail, nullptr), other.head);
+            set_links(other.head, tail, next_of(other.head, nullptr));
+        } else {
+            head = other.head;
+        }
+        tail = other.tail;
+        size_ += other.size_;
+        if constexpr (has_counters) {
+            counters_ += other.counters_;
+        }
+        other.head = other.tail = nullptr;
+        other.size_ = 0;
+        other.drop_finger();
+    }
+
+    // Для тривиально разрушаемых T элементы не обходятся; с пулом узлов
+    // цепочка целиком переходит в пул за O(1).
     void clear() noexcept {
-        node_struct* cur_node = head;
-        while (cur_node) {
-            node_struct* next_node = cur_node->next;
-            for (std::size_t i = 0; i < cur_node->count; ++i) {
-                cur_node->destroy_elem(i);
+        hook_scope scope(hooks_, unrolled_list_event::clear, size_);
+        if constexpr (has_pool) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for_each_node([](node_struct* n, node_struct*) {
+                    destroy_elems(n);
+                });
+            }
+            if (head) {
+                pool_chain(head, tail);
             }
-            deallocate_node(cur_node);
-            cur_node = next_node;
+        } else {
+            for_each_node([&](node_struct* n, node_struct*) {
+                destroy_elems(n);
+                deallocate_node(n);
+            });
         }
         head = nullptr;
         tail = nullptr;
         size_ = 0;
+        drop_finger();
+    }
+    // Возвращает аллокатору узлы из пула (Policy::node_pool).
+    void release_node_pool() noexcept {
+        if constexpr (has_pool) {
+            node_struct* before = nullptr;
+            node_struct* n = std::exchange(pool_, nullptr);
+            while (n) {
+                node_struct* next = next_of(n, before);
+                before = n;
+                free_node(n);
+                n = next;
+            }
+        }
+    }
+    size_type pooled_node_count() const noexcept {
+        size_type nodes = 0;
+        if constexpr (has_pool) {
+            node_struct* before = nullptr;
+            for (node_struct* n = pool_; n; ++nodes) {
+                node_struct* next = next_of(n, before);
+                before = n;
+                n = next;
+            }
+        }
+        return nodes;
     }
 
     void push_back(const T& val) {
@@ -428,20 +722,21 @@ public:
             node_struct* nd = allocate_node();
             nd->construct_elem(0, val);
             nd->count = 1;
+            summary_add(nd, 0);
             head = tail = nd;
             size_ = 1;
         } else {
             if (tail->count < NodeMaxSize) {
                 tail->construct_elem(tail->count, val);
+                summary_add(tail, tail->count);
                 tail->count++;
                 size_++;
             } else {
                 node_struct* nd = allocate_node();
                 nd->construct_elem(0, val);
                 nd->count = 1;
-                tail->next = nd;
-                nd->prev = tail;
-                tail = nd;
+                summary_add(nd, 0);
+                attach_back(nd);
                 size_++;
             }
         }
@@ -451,20 +746,21 @@ public:
             node_struct* nd = allocate_node();
             nd->construct_elem(0, std::move(val));
             nd->count = 1;
+            summary_add(nd, 0);
             head = tail = nd;
             size_ = 1;
         } else {
             if (tail->count < NodeMaxSize) {
                 tail->construct_elem(tail->count, std::move(val));
+                summary_add(tail, tail->count);
                 tail->count++;
                 size_++;
             } else {
                 node_struct* nd = allocate_node();
                 nd->construct_elem(0, std::move(val));
                 nd->count = 1;
-                tail->next = nd;
-                nd->prev = tail;
-                tail = nd;
+                summary_add(nd, 0);
+                attach_back(nd);
                 size_++;
             }
         }
@@ -476,14 +772,16 @@ public:
             tail->destroy_elem(tail->count - 1);
             tail->count--;
             --size_;
+            summary_rebuild(tail);
             if (tail->count == 0) {
+                drop_finger();
                 if (head == tail) {
                     deallocate_node(tail);
                     head = tail = nullptr;
                 } else {
                     node_struct* tmp = tail;
-                    tail = tail->prev;
-                    tail->next = nullptr;
+                    tail = prev_of(tmp, nullptr);
+                    set_links(tail, prev_of(tail, tmp), nullptr);
                     deallocate_node(tmp);
                 }
             }
@@ -491,83 +789,139 @@ public:
     }
 
     void push_front(const T& val) {
+        drop_finger();
         if (!head) {
             node_struct* nd = allocate_node();
             nd->construct_elem(0, val);
             nd->count = 1;
+            summary_add(nd, 0);
             head = tail = nd;
             size_ = 1;
         } else {
             if (head->count < NodeMaxSize) {
-                for (std::size_t i = head->count; i > 0; i--) {
-                    head->construct_elem(i, std::move(*(head->get_ptr(i - 1))));
-                    head->destroy_elem(i - 1);
+                count_op(&unrolled_list_counters::shifts, head->count);
+                {
+                    hook_scope scope(hooks_, unrolled_list_event::shift, head->count);
+                    for (std::size_t i = head->count; i > 0; i--) {
+                        head->construct_elem(i, std::move(*(head->get_ptr(i - 1))));
+                        head->destroy_elem(i - 1);
+                    }
                 }
                 head->construct_elem(0, val);
+                summary_add(head, 0);
                 head->count++;
                 ++size_;
             } else {
                 node_struct* nd = allocate_node();
                 nd->construct_elem(0, val);
                 nd->count = 1;
-                nd->next = head;
-                head->prev = nd;
-                head = nd;
+                summary_add(nd, 0);
+                attach_front(nd);
                 ++size_;
             }
         }
     }
     void push_front(T&& val) {
+        drop_finger();
         if (!head) {
             node_struct* nd = allocate_node();
             nd->construct_elem(0, std::move(val));
             nd->count = 1;
+            summary_add(nd, 0);
             head = tail = nd;
             size_ = 1;
         } else {
             if (head->count < NodeMaxSize) {
-                for (std::size_t i = head->count; i > 0; i--) {
-                    head->construct_elem(i, std::move(*(head->get_ptr(i - 1))));
-                    head->destroy_elem(i - 1);
+                count_op(&unrolled_list_counters::shifts, head->count);
+                {
+                    hook_scope scope(hooks_, unrolled_list_event::shift, head->count);
+                    for (std::size_t i = head->count; i > 0; i--) {
+                        head->construct_elem(i, std::move(*(head->get_ptr(i - 1))));
+                        head->destroy_elem(i - 1);
+                    }
                 }
                 head->construct_elem(0, std::move(val));
+                summary_add(head, 0);
                 head->count++;
                 ++size_;
             } else {
                 node_struct* nd = allocate_node();
                 nd->construct_elem(0, std::move(val));
                 nd->count = 1;
-                nd->next = head;
-                head->prev = nd;
-                head = nd;
+                summary_add(nd, 0);
+                attach_front(nd);
                 ++size_;
             }
         }
     }
     void pop_front() noexcept {
         if (!head) return;
+        drop_finger();
         if (head->count > 0) {
             head->destroy_elem(0);
-            for (std::size_t i = 1; i < head->count; i++) {
-                head->construct_elem(i - 1, std::move(*(head->get_ptr(i))));
-                head->destroy_elem(i);
+            count_op(&unrolled_list_counters::shifts, head->count - 1);
+            {
+                hook_scope scope(hooks_, unrolled_list_event::shift, head->count - 1);
+                for (std::size_t i = 1; i < head->count; i++) {
+                    head->construct_elem(i - 1, std::move(*(head->get_ptr(i))));
+                    head->destroy_elem(i);
+                }
             }
             head->count--;
             --size_;
+            summary_rebuild(head);
             if (head->count == 0) {
                 if (head == tail) {
                     deallocate_node(head);
                     head = tail = nullptr;
                 } else {
                     node_struct* tmp = head;
-                    head = head->next;
-                    if (head) head->prev = nullptr;
+                    head = next_of(tmp, nullptr);
+                    set_links(head, nullptr, next_of(head, tmp));
                     deallocate_node(tmp);
                 }
             }
         }
     }
 
+    // Элемент по номеру. Обход идёт от ближайшего из head, tail и «пальца» —
+    // узла предыдущего обращения, так что подряд идущие и близкие номера
+    // стоят O(1) узлов. Палец запоминают только неконстантные версии:
+    // константные обращения из разных потоков не пишут в список.
+    T& operator[](size_type pos) noexcept {
+        position at = locate(pos);
+        remember(at);
+        return *(at.node->get_ptr(pos - at.start));
+    }
+    const T& operator[](size_type pos) const noexcept {
+        position at = locate(pos);
+        return *(at.node->get_ptr(pos - at.start));
+    }
+    T& at(size_type pos) {
+        if (pos >= size_) {
+            throw std::out_of_range("unrolled_list::at");
+        }
+        return (*this)[pos];
+    }
+    const T& at(size_type pos) const {
+        if (pos >= size_) {
+            throw std::out_of_range("unrolled_list::at");
+        }
+        return (*this)[pos];
+    }
+    // Итератор на элемент pos или end(), если pos >= size().
+    iterator nth(size_type pos) noexcept {
+        if (pos >= size_) return end();
+        position at = locate(pos);
+        remember(at);
+        return iterator(at.node, pos - at.start, at.before);
+    }
+    const_iterator nth(size_type pos) const noexcept {
+        if (pos >= size_) return end();
+        position at = locate(pos);
+        return const_iterator(at.node, pos - at.start, at.before);
+    }
+
     T& front() {
         return *(head->get_ptr(0));
     }
@@ -586,6 +940,7 @@ public:
         iterator res;
         while (first != last) {
             res = insert(pos, *first);
+            pos = res;
             ++first;
             ++pos;
         }
@@ -595,6 +950,7 @@ public:
         iterator ret;
         for (auto&& val : il) {
             ret = insert(pos, val);
+            pos = ret;
             ++pos;
         }
         return ret;
@@ -603,6 +959,7 @@ public:
         iterator ret;
         for (size_type i = 0; i < n; i++) {
             ret = insert(pos, val);
+            pos = ret;
             ++pos;
         }
         return ret;
@@ -611,7 +968,7 @@ public:
         if (!pos.node_ptr) {
             push_back(val);
             if (tail) {
-                return iterator(tail, tail->count - 1);
+                return iterator(tail, tail->count - 1, prev_of(tail, nullptr));
             } else {
                 return iterator(nullptr, 0);
             }
@@ -624,7 +981,7 @@ public:
             if (!tail) {
                 return iterator(nullptr, 0);
             } else {
-                return iterator(tail, tail->count - 1);
+                return iterator(tail, tail->count - 1, prev_of(tail, nullptr));
             }
         }
         return do_insert(pos, std::move(val));
@@ -634,109 +991,655 @@ public:
         return do_erase(pos);
     }
     iterator erase(const_iterator first_it, const_iterator last_it) {
-        while (first_it != last_it) {
-            first_it = erase(first_it);
+        iterator res(first_it.node_ptr, first_it.index(), first_it.node_before());
+        for (auto n = std::distance(first_it, last_it); n > 0; --n) {
+            res = erase(res);
+        }
+        return res;
+    }
+
+    // Обходит только узлы, чью сводку summary_pred не отбросил, и вызывает
+    // fn для каждого элемента, удовлетворяющего pred.
+    template<typename Pred, typename SummaryPred, typename Fn>
+    scan_stats scan(Pred pred, SummaryPred summary_pred, Fn fn) const {
+        scan_stats stats;
+        for_each_node([&](const node_struct* n, const node_struct* before) {
+            if (!summary_pred(n->summary)) {
+                ++stats.nodes_skipped;
+                return;
+            }
+            ++stats.nodes_scanned;
+            prefetch_ahead(n, before);
+            for (std::size_t i = 0; i < n->count; ++i) {
+                const T& val = *(n->get_ptr(i));
+                if (pred(val)) {
+                    ++stats.matches;
+                    fn(val);
+                }
+            }
+        });
+        return stats;
+    }
+    template<typename Pred, typename SummaryPred>
+    scan_stats scan(Pred pred, SummaryPred summary_pred) const {
+        return scan(pred, summary_pred, [](const T&) {});
+    }
+
+    // Сводки пересчитываются при вставке и удалении; после изменения элементов
+    // через ссылки или итераторы их нужно пересчитать явно.
+    void refresh_summaries() noexcept {
+        for_each_node([&](node_struct* n, node_struct*) {
+            summary_rebuild(n);
+        });
+    }
+
+    hooks_type& hooks() noexcept {
+        return hooks_;
+    }
+    const hooks_type& hooks() const noexcept {
+        return hooks_;
+    }
+
+    // Обходит узлы за O(число узлов). Счётчики заполнены, только если
+    // Policy::count_operations включён.
+    list_stats stats() const {
+        list_stats st;
+        st.min_fill = head ? NodeMaxSize : 0;
+        for_each_node([&](const node_struct* n, const node_struct*) {
+            ++st.nodes;
+            ++st.fill_histogram[n->count];
+            st.min_fill = std::min<size_type>(st.min_fill, n->count);
+            st.max_fill = std::max<size_type>(st.max_fill, n->count);
+        });
+        st.elements = size_;
+        st.avg_fill = st.nodes ? static_cast<double>(size_) / static_cast<double>(st.nodes) : 0.0;
+        st.bytes_allocated = st.nodes * sizeof(node_struct);
+        st.bytes_used = size_ * sizeof(T);
+        if constexpr (has_counters) {
+            st.counters = counters_;
+        }
+        return st;
+    }
+
+    // Формат: заголовок (сигнатура, версия, метка порядка байт, sizeof(T),
+    // NodeMaxSize, число элементов и узлов), затем по каждому узлу его count
+    // и элементы. Для тривиально копируемых T узел пишется и читается одним
+    // вызовом прямо из storage / в storage.
+    void serialize(std::ostream& os) const {
+        write_to(os);
+        if (!os) {
+            throw std::runtime_error("unrolled_list: serialization failed");
+        }
+    }
+    void serialize(std::vector<std::byte>& out) const {
+        buffer_writer writer{out};
+        write_to(writer);
+    }
+    void deserialize(std::istream& is) {
+        read_from(is);
+    }
+    void deserialize(std::span<const std::byte> in) {
+        buffer_reader reader{in};
+        read_from(reader);
+    }
+
+    // Вызывает fn(std::span<const std::byte>) для storage каждого узла:
+    // содержимое списка можно отправить без промежуточного буфера.
+    template<typename Fn>
+    void for_each_segment(Fn fn) const {
+        static_assert(std::is_trivially_copyable_v<T>, "segments expose raw bytes of T");
+        for_each_node([&](const node_struct* n, const node_struct* before) {
+            prefetch_ahead(n, before);
+            fn(std::span<const std::byte>(reinterpret_cast<const std::byte*>(n->storage), n->count * sizeof(T)));
+        });
+    }
+
+    // Дочитывает поток до конца прямо в storage узлов: сначала в свободное
+    // место хвостового узла, затем в новые узлы, по одному read на узел.
+    // Неполная последняя запись не добавляется, её длина возвращается
+    // в trailing_bytes.
+    append_result append_from(std::istream& is) {
+        return append_raw([&](char* dst, std::size_t n) -> std::size_t {
+            is.read(dst, static_cast<std::streamsize>(n));
+            if (is.bad()) {
+                throw std::runtime_error("unrolled_list: read failed");
+            }
+            return static_cast<std::size_t>(is.gcount());
+        });
+    }
+
+#ifdef UNROLLED_LIST_HAS_POSIX_IO
+    // Дописывает в out по iovec на узел и возвращает общее число байт.
+    // Векторы действительны, пока список не изменяется.
+    size_type export_iovecs(std::vector<iovec>& out) const {
+        size_type bytes = 0;
+        for_each_segment([&](std::span<const std::byte> seg) {
+            out.push_back(iovec{const_cast<std::byte*>(seg.data()), seg.size()});
+            bytes += seg.size();
+        });
+        return bytes;
+    }
+
+    // Пишет содержимое в fd вызовами writev пачками до IOV_MAX векторов,
+    // дописывая остаток после частичной записи.
+    size_type write_fd(int fd) const {
+        std::vector<iovec> vecs;
+        size_type total = export_iovecs(vecs);
+        std::size_t first = 0;
+        while (first < vecs.size()) {
+            int batch = static_cast<int>(std::min<std::size_t>(vecs.size() - first, IOV_MAX));
+            ssize_t written = ::writev(fd, vecs.data() + first, batch);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "unrolled_list: writev");
+            }
+            std::size_t left = static_cast<std::size_t>(written);
+            while (first < vecs.size() && left >= vecs[first].iov_len) {
+                left -= vecs[first].iov_len;
+                ++first;
+            }
+            if (left > 0) {
+                vecs[first].iov_base = static_cast<char*>(vecs[first].iov_base) + left;
+                vecs[first].iov_len -= left;
+            }
         }
-        return iterator(last_it.node_ptr, last_it.index);
+        return total;
     }
 
+    append_result append_from(int fd) {
+        return append_raw([&](char* dst, std::size_t n) -> std::size_t {
+            for (;;) {
+                ssize_t got = ::read(fd, dst, n);
+                if (got >= 0) return static_cast<std::size_t>(got);
+                if (errno != EINTR) {
+                    throw std::system_error(errno, std::generic_category(), "unrolled_list: read");
+                }
+            }
+        });
+    }
+#endif
+
 private:
-    iterator do_insert(const_iterator pos, const T& val) {
-        node_struct* n = pos.node_ptr;
-        if (n->count < NodeMaxSize) {
-            n->construct_elem(n->count, val);
-            ++n->count;
-            ++size_;
-            return iterator(n, n->count - 1);
-        } else {
-            node_struct* nd = allocate_node();
-            nd->construct_elem(0, val);
-            nd->count = 1;
-            ++size_;
-            nd->next = n->next;
-            if (n->next) {
-                n->next->prev = nd;
+    static constexpr std::uint32_t format_magic   = 0x54534C55;
+    static constexpr std::uint32_t format_version = 1;
+    static constexpr std::uint32_t format_endian  = 0x01020304;
+
+    static constexpr bool custom_serializer = requires(std::ostream& os, std::istream& is, const T& val) {
+        unrolled_list_serializer<T>::write(os, val);
+        { unrolled_list_serializer<T>::read(is) } -> std::convertible_to<T>;
+    };
+    static constexpr bool raw_serializer = !custom_serializer && std::is_trivially_copyable_v<T>;
+
+    struct buffer_writer {
+        std::vector<std::byte>& out;
+
+        buffer_writer& write(const char* data, std::streamsize n) {
+            const std::byte* bytes = reinterpret_cast<const std::byte*>(data);
+            out.insert(out.end(), bytes, bytes + n);
+            return *this;
+        }
+        explicit operator bool() const noexcept {
+            return true;
+        }
+    };
+    struct buffer_reader {
+        std::span<const std::byte> in;
+        bool ok = true;
+
+        buffer_reader& read(char* data, std::streamsize n) {
+            if (!ok || static_cast<std::size_t>(n) > in.size()) {
+                ok = false;
+                return *this;
+            }
+            std::memcpy(data, in.data(), static_cast<std::size_t>(n));
+            in = in.subspan(static_cast<std::size_t>(n));
+            return *this;
+        }
+        explicit operator bool() const noexcept {
+            return ok;
+        }
+        bool operator!() const noexcept {
+            return !ok;
+        }
+    };
+
+    template<typename Out, typename U>
+    static void write_pod(Out& out, const U& val) {
+        out.write(reinterpret_cast<const char*>(&val), sizeof(U));
+    }
+    template<typename In, typename U>
+    static void read_pod(In& in, U& val) {
+        if (!in.read(reinterpret_cast<char*>(&val), sizeof(U))) {
+            throw std::runtime_error("unrolled_list: truncated input");
+        }
+    }
+
+    template<typename Out>
+    void write_to(Out& out) const {
+        static_assert(custom_serializer || raw_serializer,
+                      "T is not trivially copyable: specialize unrolled_list_serializer<T>");
+        std::uint64_t node_count = 0;
+        for_each_node([&](const node_struct*, const node_struct*) {
+            ++node_count;
+        });
+        write_pod(out, format_magic);
+        write_pod(out, format_version);
+        write_pod(out, format_endian);
+        write_pod(out, static_cast<std::uint32_t>(sizeof(T)));
+        write_pod(out, static_cast<std::uint64_t>(NodeMaxSize));
+        write_pod(out, static_cast<std::uint64_t>(size_));
+        write_pod(out, node_count);
+        for_each_node([&](const node_struct* n, const node_struct*) {
+            write_pod(out, static_cast<std::uint32_t>(n->count));
+            if constexpr (raw_serializer) {
+                out.write(reinterpret_cast<const char*>(n->storage), static_cast<std::streamsize>(n->count * sizeof(T)));
+            } else {
+                for (std::size_t i = 0; i < n->count; ++i) {
+                    unrolled_list_serializer<T>::write(out, *(n->get_ptr(i)));
+                }
+            }
+        });
+    }
+
+    // Читает во временный список и подменяет содержимое только при успехе.
+    template<typename In>
+    void read_from(In& in) {
+        static_assert(custom_serializer || raw_serializer,
+                      "T is not trivially copyable: specialize unrolled_list_serializer<T>");
+        std::uint32_t magic, version, endian, elem_size;
+        std::uint64_t node_max, total, node_count;
+        read_pod(in, magic);
+        read_pod(in, version);
+        read_pod(in, endian);
+        read_pod(in, elem_size);
+        read_pod(in, node_max);
+        read_pod(in, total);
+        read_pod(in, node_count);
+        if (magic != format_magic || version != format_version) {
+            throw std::runtime_error("unrolled_list: unknown serialization format");
+        }
+        if (endian != format_endian || elem_size != sizeof(T)) {
+            throw std::runtime_error("unrolled_list: incompatible serialized layout");
+        }
+
+        unrolled_list temp(val_alloc);
+        for (std::uint64_t k = 0; k < node_count; ++k) {
+            std::uint32_t cnt;
+            read_pod(in, cnt);
+            if constexpr (raw_serializer) {
+                while (cnt > 0) {
+                    std::size_t chunk = std::min<std::size_t>(cnt, NodeMaxSize);
+                    node_struct* nd = temp.allocate_node();
+                    if (!in.read(reinterpret_cast<char*>(nd->storage), static_cast<std::streamsize>(chunk * sizeof(T)))) {
+                        temp.deallocate_node(nd);
+                        throw std::runtime_error("unrolled_list: truncated input");
+                    }
+                    nd->count = static_cast<count_type>(chunk);
+                    temp.link_back(nd);
+                    temp.size_ += chunk;
+                    cnt -= static_cast<std::uint32_t>(chunk);
+                }
+            } else {
+                for (std::uint32_t i = 0; i < cnt; ++i) {
+                    temp.push_back(unrolled_list_serializer<T>::read(in));
+                    if (!in) {
+                        throw std::runtime_error("unrolled_list: truncated input");
+                    }
+                }
             }
-            n->next = nd;
-            nd->prev = n;
-            if (n == tail) {
-                tail = nd;
+        }
+        if (temp.size_ != total) {
+            throw std::runtime_error("unrolled_list: element count mismatch");
+        }
+        if constexpr (has_counters) {
+            counters_ += temp.counters_;
+        }
+        swap_nodes(temp);
+    }
+
+    // read_some(dst, n) читает до n байт и возвращает 0 в конце ввода.
+    // При исключении уже прочитанные целые записи остаются в списке.
+    template<typename ReadFn>
+    append_result append_raw(ReadFn read_some) {
+        static_assert(std::is_trivially_copyable_v<T>, "append_from reads raw bytes of T");
+        constexpr std::size_t capacity = NodeMaxSize * sizeof(T);
+        append_result result;
+        bool eof = false;
+        while (!eof) {
+            node_struct* n = tail;
+            bool fresh = !n || n->count == NodeMaxSize;
+            if (fresh) {
+                n = allocate_node();
             }
-            return iterator(nd, 0);
+            std::size_t filled = n->count * sizeof(T);
+            auto commit = [&] {
+                std::size_t complete = filled / sizeof(T);
+                result.elements += complete - n->count;
+                result.trailing_bytes = filled % sizeof(T);
+                size_ += complete - n->count;
+                n->count = static_cast<count_type>(complete);
+                if (!fresh) {
+                    summary_rebuild(n);
+                } else if (complete > 0) {
+                    link_back(n);
+                } else {
+                    deallocate_node(n);
+                }
+            };
+            try {
+                while (filled < capacity) {
+                    std::size_t got = read_some(reinterpret_cast<char*>(n->storage) + filled, capacity - filled);
+                    if (got == 0) {
+                        eof = true;
+                        break;
+                    }
+                    filled += got;
+                }
+            } catch (...) {
+                commit();
+                throw;
+            }
+            commit();
         }
+        return result;
     }
-    iterator do_insert(const_iterator pos, T&& val) {
-        node_struct* n = pos.node_ptr;
-        if (n->count < NodeMaxSize) {
-            n->construct_elem(n->count, std::move(val));
-            ++n->count;
-            ++size_;
-            return iterator(n, n->count - 1);
+
+    struct position {
+        node_struct* node;
+        node_struct* before;
+        size_type    start;
+    };
+
+    // Узел с элементом pos < size_. Расстояние до кандидатов оценивается
+    // в элементах.
+    position locate(size_type pos) const noexcept {
+        position at{head, nullptr, 0};
+        size_type distance = pos;
+        size_type tail_start = size_ - tail->count;
+        size_type from_tail = pos >= tail_start ? 0 : tail_start - pos;
+        if (from_tail < distance) {
+            at = position{tail, prev_of(tail, nullptr), tail_start};
+            distance = from_tail;
+        }
+        if (finger_.node) {
+            size_type from_finger = pos >= finger_.start ? pos - finger_.start : finger_.start - pos;
+            if (from_finger < distance) {
+                at = position{finger_.node, finger_.before, finger_.start};
+            }
+        }
+        while (pos < at.start) {
+            node_struct* p = at.before;
+            at.before = prev_of(p, at.node);
+            at.node = p;
+            at.start -= p->count;
+        }
+        while (pos - at.start >= at.node->count) {
+            at.start += at.node->count;
+            node_struct* nx = next_of(at.node, at.before);
+            at.before = at.node;
+            at.node = nx;
+        }
+        return at;
+    }
+    void remember(const position& at) noexcept {
+        finger_ = finger_type{at.node, at.before, at.start};
+    }
+    void drop_finger() noexcept {
+        finger_.node = nullptr;
+    }
+
+    // Обходит узлы от head и вызывает fn(node, предыдущий узел). Следующий
+    // узел вычисляется до вызова, так что fn может освободить node.
+    template<typename Fn>
+    void for_each_node(Fn fn) const {
+        node_struct* before = nullptr;
+        node_struct* n = head;
+        while (n) {
+            node_struct* next = next_of(n, before);
+            fn(n, before);
+            before = n;
+            n = next;
+        }
+    }
+
+    void attach_back(node_struct* nd) noexcept {
+        if (tail) {
+            set_links(tail, prev_of(tail, nullptr), nd);
         } else {
-            node_struct* nd = allocate_node();
-            nd->construct_elem(0, std::move(val));
-            nd->count = 1;
-            ++size_;
-            nd->next = n->next;
-            if (n->next) {
-                n->next->prev = nd;
+            head = nd;
+        }
+        set_links(nd, tail, nullptr);
+        tail = nd;
+    }
+    void attach_front(node_struct* nd) noexcept {
+        if (head) {
+            set_links(head, nd, next_of(head, nullptr));
+        } else {
+            tail = nd;
+        }
+        set_links(nd, nullptr, head);
+        head = nd;
+    }
+    // Обменивает только цепочки узлов; счётчики, хуки и пул остаются
+    // у своих списков. Аллокаторы должны быть равны.
+    void swap_nodes(unrolled_list& other) noexcept {
+        using std::swap;
+        swap(head,  other.head);
+        swap(tail,  other.tail);
+        swap(size_, other.size_);
+        drop_finger();
+        other.drop_finger();
+    }
+    void link_back(node_struct* nd) noexcept {
+        attach_back(nd);
+        summary_rebuild(nd);
+    }
+
+    template<typename U>
+    iterator do_insert(const_iterator pos, U&& val) {
+        drop_finger();
+        node_struct* n = pos.node_ptr;
+        node_struct* before = pos.node_before();
+        std::size_t idx = pos.index();
+        if (n->count == NodeMaxSize) {
+            // val может ссылаться на элемент, который split_node переместит.
+            T tmp(std::forward<U>(val));
+            split_node(n, before);
+            if (idx > n->count) {
+                idx -= n->count;
+                node_struct* upper = next_of(n, before);
+                before = n;
+                n = upper;
             }
-            n->next = nd;
-            nd->prev = n;
-            if (n == tail) {
-                tail = nd;
+            return place(n, idx, before, std::move(tmp));
+        }
+        return place(n, idx, before, std::forward<U>(val));
+    }
+    template<typename U>
+    iterator place(node_struct* n, std::size_t idx, node_struct* before, U&& val) {
+        if (idx == n->count) {
+            n->construct_elem(idx, std::forward<U>(val));
+        } else {
+            T tmp(std::forward<U>(val));
+            count_op(&unrolled_list_counters::shifts, n->count - idx);
+            hook_scope scope(hooks_, unrolled_list_event::shift, n->count - idx);
+            n->construct_elem(n->count, std::move(*(n->get_ptr(n->count - 1))));
+            for (std::size_t i = n->count - 1; i > idx; --i) {
+                *(n->get_ptr(i)) = std::move(*(n->get_ptr(i - 1)));
             }
-            return iterator(nd, 0);
+            *(n->get_ptr(idx)) = std::move(tmp);
         }
+        ++n->count;
+        ++size_;
+        summary_add(n, idx);
+        return iterator(n, idx, before);
     }
     iterator do_erase(const_iterator pos) noexcept {
         node_struct* n = pos.node_ptr;
         if (!n) return end();
+        drop_finger();
 
-        std::size_t idx = pos.index;
-        if (n->count > 1) {
-            n->destroy_elem(idx);
-            --n->count;
-            --size_;
-            return iterator(n, idx);
+        node_struct* before = pos.node_before();
+        std::size_t idx = pos.index();
+        count_op(&unrolled_list_counters::shifts, n->count - idx - 1);
+        {
+            hook_scope scope(hooks_, unrolled_list_event::shift, n->count - idx - 1);
+            for (std::size_t i = idx; i + 1 < n->count; ++i) {
+                *(n->get_ptr(i)) = std::move(*(n->get_ptr(i + 1)));
+            }
+        }
+        n->destroy_elem(n->count - 1);
+        --n->count;
+        --size_;
+        if (n->count == 0) {
+            node_struct* nx = next_of(n, before);
+            unlink_node(n, before);
+            return iterator(nx, 0, before);
+        }
+        summary_rebuild(n);
+        if (idx == n->count) {
+            return iterator(next_of(n, before), 0, n);
+        }
+        return iterator(n, idx, before);
+    }
+
+    // Переносит старшую половину полного узла в новый узел сразу за ним.
+    void split_node(node_struct* n, node_struct* before) {
+        hook_scope scope(hooks_, unrolled_list_event::split, n->count - n->count / 2);
+        node_struct* nd = allocate_node();
+        std::size_t half = n->count / 2;
+        count_op(&unrolled_list_counters::splits);
+        count_op(&unrolled_list_counters::shifts, n->count - half);
+        for (std::size_t i = half; i < n->count; ++i) {
+            nd->construct_elem(i - half, std::move(*(n->get_ptr(i))));
+            n->destroy_elem(i);
+        }
+        nd->count = static_cast<count_type>(n->count - half);
+        n->count = static_cast<count_type>(half);
+        node_struct* after = next_of(n, before);
+        set_links(nd, n, after);
+        if (after) {
+            set_links(after, nd, next_of(after, n));
+        }
+        set_links(n, before, nd);
+        if (n == tail) {
+            tail = nd;
+        }
+        summary_rebuild(n);
+        summary_rebuild(nd);
+    }
+    void unlink_node(node_struct* n, node_struct* before) noexcept {
+        node_struct* after = next_of(n, before);
+        if (before) {
+            set_links(before, prev_of(before, n), after);
         } else {
-            --n->count;
-            --size_;
-            if (n == head && n == tail) {
-                deallocate_node(n);
-                head = tail = nullptr;
-                return end();
-            } else if (n == head) {
-                head = n->next;
-                if (head) head->prev = nullptr;
-                deallocate_node(n);
-                return iterator(head, 0);
-            } else if (n == tail) {
-                tail = n->prev;
-                if (tail) tail->next = nullptr;
-                deallocate_node(n);
-                return end();
-            } else {
-                node_struct* p = n->prev;
-                node_struct* nx = n->next;
-                if (p) p->next = nx;
-                if (nx) nx->prev = p;
-                deallocate_node(n);
-                return iterator(nx, 0);
+            head = after;
+        }
+        if (after) {
+            set_links(after, before, next_of(after, n));
+        } else {
+            tail = before;
+        }
+        deallocate_node(n);
+    }
+
+    // Подгружает в кэш заголовок и начало storage узлов, следующих за n;
+    // before — узел перед n.
+    static void prefetch_ahead(const node_struct* n, const node_struct* before) noexcept {
+        if constexpr (Policy::prefetch_distance > 0) {
+            constexpr std::size_t lines = std::min<std::size_t>((sizeof(node_struct) + 63) / 64, 4);
+            const node_struct* ahead = next_of(n, before);
+            for (std::size_t d = 1; ahead; ++d) {
+                for (std::size_t k = 0; k < lines; ++k) {
+                    prefetch(reinterpret_cast<const char*>(ahead) + k * 64);
+                }
+                if (d == Policy::prefetch_distance) break;
+                const node_struct* next = next_of(ahead, n);
+                n = ahead;
+                ahead = next;
             }
         }
     }
+    static void prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p, 0, 3);
+#else
+        (void)p;
+#endif
+    }
 
+    void count_op(std::size_t unrolled_list_counters::*field, std::size_t n = 1) noexcept {
+        if constexpr (has_counters) {
+            counters_.*field += n;
+        }
+    }
+
+    static void destroy_elems(node_struct* n) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i = 0; i < n->count; ++i) {
+                n->destroy_elem(i);
+            }
+        }
+    }
+
+    void summary_add(node_struct* n, std::size_t idx) noexcept {
+        if constexpr (has_summary) {
+            n->summary.add(*(n->get_ptr(idx)));
+        }
+    }
+    void summary_rebuild(node_struct* n) noexcept {
+        if constexpr (has_summary) {
+            n->summary.reset();
+            for (std::size_t i = 0; i < n->count; ++i) {
+                n->summary.add(*(n->get_ptr(i)));
+            }
+        }
+    }
 
     node_struct* allocate_node() {
-        Node_Tag* raw_mem = node_alloc.allocate(1);
+        if constexpr (has_pool) {
+            if (pool_) {
+                node_struct* nd = pool_;
+                pool_ = next_of(nd, nullptr);
+                if (pool_) {
+                    set_links(pool_, nullptr, next_of(pool_, nd));
+                }
+                nd->~node_struct();
+                return new (static_cast<void*>(nd)) node_struct();
+            }
+        }
+        hook_scope scope(hooks_, unrolled_list_event::node_allocate, 1);
+        node_struct* raw_mem = node_alloc.allocate(1);
         void* raw_ptr = static_cast<void*>(raw_mem);
         node_struct* nd = new (raw_ptr) node_struct();
+        count_op(&unrolled_list_counters::allocations);
         return nd;
     }
+    // Узел без элементов, уже отвязанный от списка.
     void deallocate_node(node_struct* nd) noexcept {
+        if constexpr (has_pool) {
+            set_links(nd, nullptr, nullptr);
+            pool_chain(nd, nd);
+        } else {
+            free_node(nd);
+        }
+    }
+    // Ставит связанную цепочку first..last в начало пула.
+    void pool_chain(node_struct* first, node_struct* last) noexcept {
+        set_links(last, prev_of(last, nullptr), pool_);
+        if (pool_) {
+            set_links(pool_, last, next_of(pool_, nullptr));
+        }
+        pool_ = first;
+    }
+    void free_node(node_struct* nd) noexcept {
+        hook_scope scope(hooks_, unrolled_list_event::node_free, 1);
         nd->~node_struct();
-        node_alloc.deallocate(reinterpret_cast<Node_Tag*>(nd), 1);
+        node_alloc.deallocate(nd, 1);
+        count_op(&unrolled_list_counters::frees);
     }
 };
 
+
+// Битовая специализация unrolled_list<bool, N>.
+#include "unrolled_list_bool.h"
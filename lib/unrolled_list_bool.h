@@ -0,0 +1,558 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "unrolled_list.h"
+
+// unrolled_list<bool, N>: узел хранит N флагов битами в 64-битных словах.
+// Как у std::vector<bool>, разыменование неконстантного итератора даёт
+// прокси-ссылку. count() считает единицы через popcount, find_first() ищет
+// установленный бит по словам, вставка и удаление внутри узла сдвигают биты
+// словными операциями. Биты за count узла всегда нулевые.
+// Policy не используется: сводки, хуки и xor-ссылки к битовым узлам
+// не применяются.
+template<std::size_t NodeMaxSize, typename Allocator, typename Policy>
+class unrolled_list<bool, NodeMaxSize, Allocator, Policy> {
+    static_assert(NodeMaxSize > 0, "NodeMaxSize must be positive");
+
+public:
+    using value_type      = bool;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+    using const_reference = bool;
+
+private:
+    using word_type = std::uint64_t;
+    using count_type = unrolled_list_count_t<NodeMaxSize>;
+
+    static constexpr std::size_t word_bits  = 64;
+    static constexpr std::size_t word_count = (NodeMaxSize + word_bits - 1) / word_bits;
+
+    struct node_struct {
+        node_struct* prev  = nullptr;
+        node_struct* next  = nullptr;
+        count_type   count = 0;
+        word_type    words[word_count] = {};
+
+        bool get(std::size_t i) const noexcept {
+            return (words[i / word_bits] >> (i % word_bits)) & 1;
+        }
+        void set(std::size_t i, bool val) noexcept {
+            word_type mask = word_type{1} << (i % word_bits);
+            words[i / word_bits] = val ? words[i / word_bits] | mask : words[i / word_bits] & ~mask;
+        }
+        // Освобождает бит idx, сдвигая биты [idx, count) на один вверх.
+        void shift_up(std::size_t idx) noexcept {
+            std::size_t first = idx / word_bits;
+            for (std::size_t i = count / word_bits; i > first; --i) {
+                words[i] = (words[i] << 1) | (words[i - 1] >> (word_bits - 1));
+            }
+            word_type low = low_mask(idx % word_bits);
+            words[first] = (words[first] & low) | ((words[first] & ~low) << 1);
+        }
+        // Удаляет бит idx, сдвигая биты (idx, count) на один вниз.
+        void shift_down(std::size_t idx) noexcept {
+            std::size_t first = idx / word_bits;
+            std::size_t last = (count - 1) / word_bits;
+            word_type low = low_mask(idx % word_bits);
+            words[first] = (words[first] & low) | ((words[first] >> 1) & ~low);
+            for (std::size_t i = first; i < last; ++i) {
+                words[i] |= words[i + 1] << (word_bits - 1);
+                words[i + 1] >>= 1;
+            }
+        }
+        // Переносит биты [from, count) в начало пустого узла dst.
+        void move_tail_to(node_struct* dst, std::size_t from) noexcept {
+            std::size_t moved = count - from;
+            for (std::size_t j = 0; j < moved; j += word_bits) {
+                dst->words[j / word_bits] = read_word(from + j) & low_mask_or_all(moved - j);
+            }
+            for (std::size_t i = from / word_bits; i < word_count; ++i) {
+                words[i] &= i == from / word_bits ? low_mask(from % word_bits) : 0;
+            }
+            dst->count = static_cast<count_type>(moved);
+            count = static_cast<count_type>(from);
+        }
+        // 64 бита начиная с pos; за концом массива — нули.
+        word_type read_word(std::size_t pos) const noexcept {
+            std::size_t w = pos / word_bits;
+            std::size_t shift = pos % word_bits;
+            word_type v = words[w] >> shift;
+            if (shift && w + 1 < word_count) {
+                v |= words[w + 1] << (word_bits - shift);
+            }
+            return v;
+        }
+
+        static word_type low_mask(std::size_t bits) noexcept {
+            return bits == 0 ? 0 : ~word_type{0} >> (word_bits - bits);
+        }
+        static word_type low_mask_or_all(std::size_t bits) noexcept {
+            return bits >= word_bits ? ~word_type{0} : low_mask(bits);
+        }
+    };
+
+    using node_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_struct>;
+
+    node_alloc_type node_alloc;
+    allocator_type  val_alloc;
+    node_struct*    head;
+    node_struct*    tail;
+    size_type       size_;
+
+public:
+    // Ссылка на бит узла.
+    class reference {
+    public:
+        reference(const reference&) = default;
+
+        operator bool() const noexcept {
+            return node->get(index);
+        }
+        reference& operator=(bool val) noexcept {
+            node->set(index, val);
+            return *this;
+        }
+        // Присваивание ссылки копирует значение бита.
+        reference& operator=(const reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+        void flip() noexcept {
+            node->set(index, !node->get(index));
+        }
+
+    private:
+        friend class unrolled_list;
+
+        reference(node_struct* n, std::size_t i) noexcept
+            : node(n), index(i)
+        {}
+
+        node_struct* node;
+        std::size_t  index;
+    };
+
+    template<bool is_const>
+    class iterators_class {
+    public:
+        using value_type        = bool;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using pointer           = void;
+        using reference         = std::conditional_t<is_const, bool, typename unrolled_list::reference>;
+
+        iterators_class(node_struct* n = nullptr, std::size_t i = 0) noexcept
+            : node_ptr(n), index(i)
+        {}
+
+        template<bool B, typename = std::enable_if_t<!B && is_const>>
+        iterators_class(const iterators_class<B>& other) noexcept
+            : node_ptr(other.node_ptr), index(other.index)
+        {}
+
+        reference operator*() const noexcept {
+            if constexpr (is_const) {
+                return node_ptr->get(index);
+            } else {
+                return reference(node_ptr, index);
+            }
+        }
+
+        // Как в основном шаблоне, ++ и -- на end() ничего не делают,
+        // а -- с первого элемента даёт end().
+        iterators_class& operator++() noexcept {
+            if (node_ptr && ++index == node_ptr->count) {
+                node_ptr = node_ptr->next;
+                index = 0;
+            }
+            return *this;
+        }
+        iterators_class operator++(int) noexcept {
+            iterators_class tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+        iterators_class& operator--() noexcept {
+            if (node_ptr) {
+                if (index != 0) {
+                    --index;
+                } else if (node_ptr->prev) {
+                    node_ptr = node_ptr->prev;
+                    index = node_ptr->count - 1;
+                } else {
+                    node_ptr = nullptr;
+                }
+            }
+            return *this;
+        }
+        iterators_class operator--(int) noexcept {
+            iterators_class tmp(*this);
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterators_class& other) const noexcept {
+            return node_ptr == other.node_ptr && index == other.index;
+        }
+        bool operator!=(const iterators_class& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        friend class unrolled_list;
+        template<bool> friend class iterators_class;
+
+        node_struct* node_ptr;
+        std::size_t  index;
+    };
+
+    using iterator       = iterators_class<false>;
+    using const_iterator = iterators_class<true>;
+
+    unrolled_list()
+        : node_alloc(), val_alloc(), head(nullptr), tail(nullptr), size_(0)
+    {}
+    explicit unrolled_list(const allocator_type& alloc)
+        : node_alloc(alloc), val_alloc(alloc), head(nullptr), tail(nullptr), size_(0)
+    {}
+    template<std::input_iterator InputIt>
+    unrolled_list(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+        : unrolled_list(alloc)
+    {
+        try {
+            for (; first != last; ++first) {
+                push_back(static_cast<bool>(*first));
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    unrolled_list(size_type n, bool val, const allocator_type& alloc = allocator_type())
+        : unrolled_list(alloc)
+    {
+        try {
+            while (n--) {
+                push_back(val);
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    unrolled_list(std::initializer_list<bool> il, const allocator_type& alloc = allocator_type())
+        : unrolled_list(il.begin(), il.end(), alloc)
+    {}
+    unrolled_list(const unrolled_list& other)
+        : unrolled_list(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.val_alloc))
+    {
+        try {
+            for (const node_struct* n = other.head; n; n = n->next) {
+                node_struct* nd = allocate_node();
+                std::copy(n->words, n->words + word_count, nd->words);
+                nd->count = n->count;
+                link_after(tail, nd);
+                size_ += n->count;
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    unrolled_list(unrolled_list&& other) noexcept
+        : node_alloc(std::move(other.node_alloc)), val_alloc(std::move(other.val_alloc)),
+          head(other.head), tail(other.tail), size_(other.size_)
+    {
+        other.head = other.tail = nullptr;
+        other.size_ = 0;
+    }
+    ~unrolled_list() {
+        clear();
+    }
+
+    unrolled_list& operator=(const unrolled_list& other) {
+        if (this != &other) {
+            unrolled_list tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    unrolled_list& operator=(unrolled_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void swap(unrolled_list& other) noexcept {
+        using std::swap;
+        swap(node_alloc, other.node_alloc);
+        swap(val_alloc,  other.val_alloc);
+        swap(head,       other.head);
+        swap(tail,       other.tail);
+        swap(size_,      other.size_);
+    }
+
+    allocator_type get_allocator() const {
+        return val_alloc;
+    }
+
+    bool operator==(const unrolled_list& rhs) const {
+        return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const unrolled_list& rhs) const {
+        return !(*this == rhs);
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    iterator begin() noexcept {
+        return iterator(head, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(head, 0);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    iterator end() noexcept {
+        return iterator(nullptr, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr, 0);
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    reference front() noexcept {
+        return reference(head, 0);
+    }
+    bool front() const noexcept {
+        return head->get(0);
+    }
+    reference back() noexcept {
+        return reference(tail, tail->count - 1);
+    }
+    bool back() const noexcept {
+        return tail->get(tail->count - 1);
+    }
+    reference operator[](size_type pos) noexcept {
+        auto [n, idx] = locate(pos);
+        return reference(n, idx);
+    }
+    bool operator[](size_type pos) const noexcept {
+        auto [n, idx] = locate(pos);
+        return n->get(idx);
+    }
+    reference at(size_type pos) {
+        if (pos >= size_) {
+            throw std::out_of_range("unrolled_list<bool>::at");
+        }
+        return (*this)[pos];
+    }
+    bool at(size_type pos) const {
+        if (pos >= size_) {
+            throw std::out_of_range("unrolled_list<bool>::at");
+        }
+        return (*this)[pos];
+    }
+
+    void push_back(bool val) {
+        if (!tail || tail->count == NodeMaxSize) {
+            link_after(tail, allocate_node());
+        }
+        tail->set(tail->count, val);
+        ++tail->count;
+        ++size_;
+    }
+    void push_front(bool val) {
+        if (!head || head->count == NodeMaxSize) {
+            link_after(nullptr, allocate_node());
+        }
+        head->shift_up(0);
+        head->set(0, val);
+        ++head->count;
+        ++size_;
+    }
+    void pop_back() noexcept {
+        if (!tail) return;
+        tail->set(tail->count - 1, false);
+        --tail->count;
+        --size_;
+        if (tail->count == 0) {
+            unlink_node(tail);
+        }
+    }
+    void pop_front() noexcept {
+        if (!head) return;
+        head->shift_down(0);
+        --head->count;
+        --size_;
+        if (head->count == 0) {
+            unlink_node(head);
+        }
+    }
+
+    iterator insert(const_iterator pos, bool val) {
+        if (!pos.node_ptr) {
+            push_back(val);
+            return iterator(tail, tail->count - 1);
+        }
+        node_struct* n = pos.node_ptr;
+        std::size_t idx = pos.index;
+        if (n->count == NodeMaxSize) {
+            node_struct* nd = allocate_node();
+            n->move_tail_to(nd, n->count / 2);
+            link_after(n, nd);
+            if (idx > n->count) {
+                idx -= n->count;
+                n = nd;
+            }
+        }
+        n->shift_up(idx);
+        n->set(idx, val);
+        ++n->count;
+        ++size_;
+        return iterator(n, idx);
+    }
+    iterator erase(const_iterator pos) noexcept {
+        node_struct* n = pos.node_ptr;
+        if (!n) return end();
+        std::size_t idx = pos.index;
+        n->shift_down(idx);
+        --n->count;
+        --size_;
+        node_struct* next = n->next;
+        if (n->count == 0) {
+            unlink_node(n);
+            return iterator(next, 0);
+        }
+        if (idx == n->count) {
+            return iterator(next, 0);
+        }
+        return iterator(n, idx);
+    }
+
+    void clear() noexcept {
+        while (head) {
+            node_struct* next = head->next;
+            deallocate_node(head);
+            head = next;
+        }
+        tail = nullptr;
+        size_ = 0;
+    }
+
+    // Число установленных флагов.
+    size_type count() const noexcept {
+        size_type ones = 0;
+        for (const node_struct* n = head; n; n = n->next) {
+            for (std::size_t w = 0; w < word_count; ++w) {
+                ones += static_cast<size_type>(std::popcount(n->words[w]));
+            }
+        }
+        return ones;
+    }
+    // Номер первого установленного флага не раньше from или size(), если
+    // такого нет.
+    size_type find_first(size_type from = 0) const noexcept {
+        if (from >= size_) return size_;
+        auto [n, idx] = locate(from);
+        size_type start = from - idx;
+        word_type mask = ~node_struct::low_mask(idx % word_bits);
+        for (std::size_t w = idx / word_bits; n; ) {
+            for (; w < word_count; ++w) {
+                word_type bits = n->words[w] & mask;
+                if (bits) {
+                    return start + w * word_bits + static_cast<size_type>(std::countr_zero(bits));
+                }
+                mask = ~word_type{0};
+            }
+            start += n->count;
+            n = n->next;
+            w = 0;
+        }
+        return size_;
+    }
+
+    size_type node_count() const noexcept {
+        size_type nodes = 0;
+        for (const node_struct* n = head; n; n = n->next) {
+            ++nodes;
+        }
+        return nodes;
+    }
+    // Байты, занятые узлами.
+    size_type bytes_allocated() const noexcept {
+        return node_count() * sizeof(node_struct);
+    }
+
+private:
+    std::pair<node_struct*, std::size_t> locate(size_type pos) const noexcept {
+        if (pos >= size_ - tail->count) {
+            return {tail, pos - (size_ - tail->count)};
+        }
+        node_struct* n = head;
+        while (pos >= n->count) {
+            pos -= n->count;
+            n = n->next;
+        }
+        return {n, pos};
+    }
+
+    // Вставляет nd после n; n == nullptr — в начало.
+    void link_after(node_struct* n, node_struct* nd) noexcept {
+        node_struct* next = n ? n->next : head;
+        nd->prev = n;
+        nd->next = next;
+        if (n) {
+            n->next = nd;
+        } else {
+            head = nd;
+        }
+        if (next) {
+            next->prev = nd;
+        } else {
+            tail = nd;
+        }
+    }
+    void unlink_node(node_struct* n) noexcept {
+        if (n->prev) {
+            n->prev->next = n->next;
+        } else {
+            head = n->next;
+        }
+        if (n->next) {
+            n->next->prev = n->prev;
+        } else {
+            tail = n->prev;
+        }
+        deallocate_node(n);
+    }
+
+    node_struct* allocate_node() {
+        node_struct* raw_mem = node_alloc.allocate(1);
+        return new (static_cast<void*>(raw_mem)) node_struct();
+    }
+    void deallocate_node(node_struct* nd) noexcept {
+        nd->~node_struct();
+        node_alloc.deallocate(nd, 1);
+    }
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Наименьший беззнаковый тип, вмещающий число элементов узла.
+template<std::size_t NodeMaxSize>
+using unrolled_list_count_t =
+    std::conditional_t<NodeMaxSize <= UINT8_MAX,  std::uint8_t,
+    std::conditional_t<NodeMaxSize <= UINT16_MAX, std::uint16_t,
+    std::conditional_t<NodeMaxSize <= UINT32_MAX, std::uint32_t, std::size_t>>>;
+
+// Место под NodeMaxSize элементов, общее для узлов unrolled_list и
+// unrolled_forward_list. Ссылки и счётчик узел добавляет сам; время жизни
+// элементов отслеживает контейнер.
+template<typename T, std::size_t NodeMaxSize>
+struct unrolled_node_storage {
+    alignas(T) unsigned char storage[NodeMaxSize * sizeof(T)];
+
+    T* get_ptr(std::size_t i) {
+        return reinterpret_cast<T*>(storage + i * sizeof(T));
+    }
+    const T* get_ptr(std::size_t i) const {
+        return reinterpret_cast<const T*>(storage + i * sizeof(T));
+    }
+    void construct_elem(std::size_t idx, const T& val) {
+        new (static_cast<void*>(get_ptr(idx))) T(val);
+    }
+    void construct_elem(std::size_t idx, T&& val) {
+        new (static_cast<void*>(get_ptr(idx))) T(std::move(val));
+    }
+    void destroy_elem(std::size_t idx) noexcept {
+        get_ptr(idx)->~T();
+    }
+};
@@ -0,0 +1,80 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+template<typename T>
+std::string to_bytes(const std::vector<T>& values) {
+    return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+}
+
+/*
+    Чтение из потока дописывает записи после уже имеющихся элементов,
+    сначала заполняя хвостовой узел; неполная последняя запись
+    отбрасывается и возвращается её длина.
+*/
+TEST(AppendFrom, streamWithTrailingPartialRecord) {
+    unrolled_list<std::uint32_t, 4> list = {100, 101};
+    std::vector<std::uint32_t> values = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    std::string bytes = to_bytes(values) + std::string("\x01\x02", 2);
+    std::istringstream stream(bytes);
+
+    auto result = list.append_from(stream);
+    ASSERT_EQ(result.elements, 9);
+    ASSERT_EQ(result.trailing_bytes, 2);
+    ASSERT_THAT(std::vector<std::uint32_t>(list.begin(), list.end()),
+                testing::ElementsAre(100, 101, 0, 1, 2, 3, 4, 5, 6, 7, 8));
+    ASSERT_EQ(list.size(), 11);
+    ASSERT_EQ(list.back(), 8);
+
+    std::istringstream empty;
+    ASSERT_EQ(list.append_from(empty).elements, 0);
+    ASSERT_EQ(list.size(), 11);
+}
+
+/*
+    Из канала записи приходят кусками произвольной длины, в том числе
+    разрезанными посередине, и всё равно собираются целиком.
+*/
+TEST(AppendFrom, fileDescriptor) {
+    std::vector<std::uint64_t> values(10000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = i * 7;
+    }
+    std::string bytes = to_bytes(values);
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    std::thread writer([&] {
+        std::size_t pos = 0;
+        std::size_t chunk = 5;
+        while (pos < bytes.size()) {
+            std::size_t n = std::min(chunk, bytes.size() - pos);
+            if (::write(fds[1], bytes.data() + pos, n) != static_cast<ssize_t>(n)) break;
+            pos += n;
+            chunk = chunk * 3 % 1001 + 1;
+        }
+        ::close(fds[1]);
+    });
+
+    unrolled_list<std::uint64_t, 16> list;
+    auto result = list.append_from(fds[0]);
+    writer.join();
+    ::close(fds[0]);
+
+    ASSERT_EQ(result.elements, values.size());
+    ASSERT_EQ(result.trailing_bytes, 0);
+    ASSERT_TRUE(std::equal(list.begin(), list.end(), values.begin(), values.end()));
+}
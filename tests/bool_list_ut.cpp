@@ -0,0 +1,128 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+template<typename List>
+void check_against_vector(unsigned seed) {
+    List list;
+    std::vector<bool> expected;
+    std::mt19937 gen(seed);
+    for (int step = 0; step < 6000; ++step) {
+        bool val = gen() % 3 == 0;
+        std::size_t pos = gen() % (expected.size() + 1);
+        switch (gen() % 8) {
+            case 0:
+            case 1: {
+                auto it = list.insert(std::next(list.begin(), static_cast<std::ptrdiff_t>(pos)), val);
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), val);
+                ASSERT_EQ(*it, val);
+                break;
+            }
+            case 2:
+                if (pos < expected.size()) {
+                    list.erase(std::next(list.begin(), static_cast<std::ptrdiff_t>(pos)));
+                    expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+                }
+                break;
+            case 3:
+                list.push_front(val);
+                expected.insert(expected.begin(), val);
+                break;
+            case 4:
+            case 5:
+                list.push_back(val);
+                expected.push_back(val);
+                break;
+            case 6:
+                if (!expected.empty()) {
+                    list.pop_front();
+                    expected.erase(expected.begin());
+                }
+                break;
+            case 7:
+                if (pos < expected.size()) {
+                    list[pos].flip();
+                    expected[pos].flip();
+                }
+                break;
+        }
+        ASSERT_EQ(list.size(), expected.size());
+    }
+    ASSERT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+    ASSERT_EQ(list.count(), static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+    for (std::size_t from = 0; from <= expected.size(); from += 7) {
+        auto it = std::find(expected.begin() + static_cast<std::ptrdiff_t>(from), expected.end(), true);
+        ASSERT_EQ(list.find_first(from), static_cast<std::size_t>(it - expected.begin()));
+    }
+}
+
+}
+
+/*
+    Вставки и удаления со сдвигом битов, в том числе через границу слов
+    и при разбиении узла, совпадают с std::vector<bool>.
+*/
+TEST(BoolList, matchesVectorBool) {
+    check_against_vector<unrolled_list<bool, 64>>(1);
+    check_against_vector<unrolled_list<bool, 100>>(2);
+    check_against_vector<unrolled_list<bool, 300>>(3);
+}
+
+/*
+    Прокси-ссылки, поиск и подсчёт на почти пустом списке;
+    флаг занимает один бит узла.
+*/
+TEST(BoolList, proxiesAndMemory) {
+    unrolled_list<bool, 256> flags(std::size_t{1000}, false);
+    ASSERT_EQ(flags.count(), 0);
+    ASSERT_EQ(flags.find_first(), 1000);
+
+    flags[700] = true;
+    flags[999] = flags[700];
+    flags.front() = true;
+    ASSERT_EQ(flags.count(), 3);
+    ASSERT_EQ(flags.find_first(), 0);
+    ASSERT_EQ(flags.find_first(1), 700);
+    ASSERT_EQ(flags.find_first(701), 999);
+    ASSERT_TRUE(flags.back());
+    ASSERT_THROW(flags.at(1000), std::out_of_range);
+
+    const auto& cref = flags;
+    ASSERT_EQ(std::count(cref.begin(), cref.end(), true), 3);
+    ASSERT_EQ(flags.node_count(), 4);
+    ASSERT_LE(flags.bytes_allocated(), 4 * (256 / 8 + 3 * sizeof(void*)));
+
+    unrolled_list<bool, 256> copy = flags;
+    ASSERT_EQ(copy, flags);
+    copy.pop_back();
+    ASSERT_NE(copy, flags);
+}
+
+/*
+    Как в основном шаблоне, -- и ++ на end() ничего не делают, -- переходит
+    через границу узла, а с первого элемента даёт end().
+*/
+TEST(BoolList, decrementAtEnds) {
+    unrolled_list<bool, 64> flags(std::size_t{65}, false);
+    flags.front() = true;
+    auto it = flags.end();
+    --it;
+    ASSERT_TRUE(it == flags.end());
+    ++it;
+    ASSERT_TRUE(it == flags.end());
+
+    it = std::next(flags.begin(), 64);
+    --it;
+    ASSERT_FALSE(*it);
+    it = flags.begin();
+    ASSERT_TRUE(*it);
+    --it;
+    ASSERT_TRUE(it == flags.end());
+}
@@ -0,0 +1,132 @@
+#include <cow_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename T>
+class NodeCountingAllocator {
+public:
+    using value_type = T;
+
+    static inline int Allocated = 0;
+    static inline int Freed = 0;
+
+    NodeCountingAllocator() = default;
+
+    template<typename U>
+    NodeCountingAllocator(const NodeCountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        ++NodeCountingAllocator<void>::Allocated;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        ++NodeCountingAllocator<void>::Freed;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const NodeCountingAllocator&) const {
+        return true;
+    }
+};
+
+template<typename Range>
+std::vector<int> to_vector(const Range& range) {
+    return std::vector<int>(range.begin(), range.end());
+}
+
+}
+
+/*
+    Снимок не видит изменений, сделанных в живом списке после его создания,
+    и наоборот.
+*/
+TEST(CowUnrolledList, snapshotIsImmutable) {
+    cow_unrolled_list<int, 4> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+
+    auto snap = list.snapshot();
+    list.set(1, 100);
+    list.erase(5);
+    list.insert(0, -1);
+    list.push_back(10);
+
+    ASSERT_THAT(to_vector(snap), testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+    ASSERT_EQ(snap.size(), 10);
+    ASSERT_EQ(snap[7], 7);
+    ASSERT_THAT(to_vector(list), testing::ElementsAre(-1, 0, 100, 2, 3, 4, 6, 7, 8, 9, 10));
+}
+
+/*
+    После снимка изменение одной позиции клонирует только один узел,
+    остальные узлы по-прежнему разделяются со снимком.
+*/
+TEST(CowUnrolledList, clonesOnlyTouchedNodes) {
+    NodeCountingAllocator<void>::Allocated = 0;
+    NodeCountingAllocator<void>::Freed = 0;
+    {
+        cow_unrolled_list<int, 8, NodeCountingAllocator<int>> list;
+        for (int i = 0; i < 80; ++i) {
+            list.push_back(i);
+        }
+        ASSERT_EQ(NodeCountingAllocator<void>::Allocated, 10);
+
+        auto snap = list.snapshot();
+        ASSERT_EQ(NodeCountingAllocator<void>::Allocated, 10);
+        ASSERT_EQ(list.shared_node_count(), 10);
+
+        list.set(42, -42);
+        ASSERT_EQ(NodeCountingAllocator<void>::Allocated, 11);
+        ASSERT_EQ(list.shared_node_count(), 9);
+
+        list.set(43, -43);
+        ASSERT_EQ(NodeCountingAllocator<void>::Allocated, 11);
+
+        ASSERT_EQ(snap[42], 42);
+        ASSERT_EQ(list[42], -42);
+    }
+    ASSERT_EQ(NodeCountingAllocator<void>::Allocated, NodeCountingAllocator<void>::Freed);
+}
+
+/*
+    Список, восстановленный из снимка, независим от исходного.
+*/
+TEST(CowUnrolledList, restoreFromSnapshot) {
+    cow_unrolled_list<int, 3> list = {1, 2, 3, 4, 5};
+    auto checkpoint = list.snapshot();
+
+    list.clear();
+    list.push_back(7);
+
+    cow_unrolled_list<int, 3> restored(checkpoint);
+    restored.pop_front();
+    restored.push_front(0);
+
+    ASSERT_THAT(to_vector(restored), testing::ElementsAre(0, 2, 3, 4, 5));
+    ASSERT_THAT(to_vector(checkpoint), testing::ElementsAre(1, 2, 3, 4, 5));
+    ASSERT_THAT(to_vector(list), testing::ElementsAre(7));
+}
+
+/*
+    Вставка значения, ссылающегося на элемент заполненного узла,
+    читает его до разделения узла.
+*/
+TEST(CowUnrolledList, insertAliasedElementIntoFullNode) {
+    cow_unrolled_list<std::string, 4> list = {"a", "b", "c", "long string to defeat small-buffer optimization"};
+    list.insert(0, list[3]);
+    ASSERT_EQ(list.size(), 5);
+    ASSERT_EQ(list[0], "long string to defeat small-buffer optimization");
+    ASSERT_EQ(list[4], "long string to defeat small-buffer optimization");
+
+    cow_unrolled_list<std::string, 4> other = {"w", "x", "y", "z"};
+    other.insert(3, other[2]);
+    std::vector<std::string> values(other.begin(), other.end());
+    ASSERT_THAT(values, testing::ElementsAre("w", "x", "y", "y", "z"));
+}
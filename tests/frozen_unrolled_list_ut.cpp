@@ -0,0 +1,162 @@
+#include <frozen_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+template<typename List>
+std::vector<typename List::value_type> to_vector(const List& list) {
+    return std::vector<typename List::value_type>(list.begin(), list.end());
+}
+
+template<typename List>
+std::vector<typename List::value_type> blocks_to_vector(const List& list) {
+    std::vector<typename List::value_type> result;
+    list.for_each_block([&](auto block) {
+        result.insert(result.end(), block.begin(), block.end());
+    });
+    return result;
+}
+
+}
+
+/*
+    Монотонные значения кодируются разностями, малые — смещением от минимума;
+    после заморозки итератор, for_each_block и operator[] видят те же значения,
+    а памяти уходит заметно меньше.
+*/
+TEST(FrozenUnrolledList, freezeKeepsValues) {
+    frozen_unrolled_list<std::uint64_t, 64> timestamps;
+    frozen_unrolled_list<std::uint64_t, 64> ids;
+    std::vector<std::uint64_t> ts_expected;
+    std::vector<std::uint64_t> id_expected;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        ts_expected.push_back(1'700'000'000'000 + i * 3 + i % 2);
+        id_expected.push_back(5'000'000 + (i * 7919) % 1000);
+        timestamps.push_back(ts_expected.back());
+        ids.push_back(id_expected.back());
+    }
+    std::size_t plain_bytes = timestamps.memory_usage();
+
+    ASSERT_EQ(timestamps.freeze(), 15);
+    ASSERT_EQ(ids.freeze(), 15);
+    ASSERT_EQ(timestamps.frozen_node_count(), 15);
+    ASSERT_LT(timestamps.memory_usage() * 4, plain_bytes);
+    ASSERT_LT(ids.memory_usage() * 2, plain_bytes);
+
+    ASSERT_EQ(to_vector(timestamps), ts_expected);
+    ASSERT_EQ(blocks_to_vector(timestamps), ts_expected);
+    ASSERT_EQ(to_vector(ids), id_expected);
+    ASSERT_EQ(blocks_to_vector(ids), id_expected);
+    for (std::size_t i = 0; i < ts_expected.size(); i += 37) {
+        ASSERT_EQ(timestamps[i], ts_expected[i]);
+        ASSERT_EQ(ids.at(i), id_expected[i]);
+    }
+    ASSERT_EQ(timestamps.back(), ts_expected.back());
+    ASSERT_THROW(ids.at(1000), std::out_of_range);
+
+    timestamps.thaw();
+    ASSERT_EQ(timestamps.frozen_node_count(), 0);
+    ASSERT_EQ(timestamps.memory_usage(), plain_bytes);
+    ASSERT_EQ(to_vector(timestamps), ts_expected);
+}
+
+/*
+    Знаковые значения по обе стороны от нуля и крайние значения типа
+    переживают заморозку; узел, который упаковка не уменьшает, остаётся
+    несжатым.
+*/
+TEST(FrozenUnrolledList, signedAndExtremes) {
+    frozen_unrolled_list<std::int32_t, 16> small;
+    std::vector<std::int32_t> small_expected;
+    for (std::int32_t i = -40; i < 40; ++i) {
+        small.push_back(i % 2 ? i : -i);
+        small_expected.push_back(i % 2 ? i : -i);
+    }
+    ASSERT_EQ(small.freeze(), 5);
+    ASSERT_EQ(to_vector(small), small_expected);
+
+    using limits = std::numeric_limits<std::int64_t>;
+    frozen_unrolled_list<std::int64_t, 4> wide = {limits::min(), limits::max(), 0, -1, 1, 2, 3, 4};
+    ASSERT_EQ(wide.freeze(), 1);
+    ASSERT_EQ(to_vector(wide), (std::vector<std::int64_t>{limits::min(), limits::max(), 0, -1, 1, 2, 3, 4}));
+}
+
+/*
+    Изменения замороженного узла размораживают его; результат совпадает
+    с тем же набором операций над std::vector.
+*/
+TEST(FrozenUnrolledList, mutationThaws) {
+    frozen_unrolled_list<std::uint32_t, 8> list;
+    std::vector<std::uint32_t> expected;
+    std::mt19937 gen(7);
+    for (std::uint32_t i = 0; i < 200; ++i) {
+        list.push_back(i * 2);
+        expected.push_back(i * 2);
+    }
+    for (int step = 0; step < 500; ++step) {
+        if (step % 50 == 0) {
+            list.freeze();
+        }
+        std::size_t pos = gen() % (expected.size() + 1);
+        switch (gen() % 6) {
+            case 0:
+                list.insert(pos, step);
+                expected.insert(expected.begin() + pos, step);
+                break;
+            case 1:
+                if (pos < expected.size()) {
+                    list.erase(pos);
+                    expected.erase(expected.begin() + pos);
+                }
+                break;
+            case 2:
+                if (pos < expected.size()) {
+                    list.set(pos, step);
+                    expected[pos] = step;
+                }
+                break;
+            case 3:
+                list.push_front(step);
+                expected.insert(expected.begin(), step);
+                break;
+            case 4:
+                list.pop_front();
+                expected.erase(expected.begin());
+                break;
+            case 5:
+                list.pop_back();
+                expected.pop_back();
+                break;
+        }
+        ASSERT_EQ(list.size(), expected.size());
+    }
+    ASSERT_EQ(to_vector(list), expected);
+    ASSERT_EQ(blocks_to_vector(list), expected);
+}
+
+/*
+    В автоматическом режиме узел замораживается, когда push_back уходит
+    в следующий; хвостовой узел остаётся несжатым.
+*/
+TEST(FrozenUnrolledList, autoFreeze) {
+    frozen_unrolled_list<std::uint64_t, 32, true> list;
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        list.push_back(i);
+    }
+    ASSERT_EQ(list.node_count(), 4);
+    ASSERT_EQ(list.frozen_node_count(), 3);
+    std::uint64_t expected = 0;
+    for (std::uint64_t val : list) {
+        ASSERT_EQ(val, expected++);
+    }
+
+    frozen_unrolled_list<std::uint64_t, 32, true> copy = list;
+    ASSERT_EQ(to_vector(copy), to_vector(list));
+}
@@ -0,0 +1,95 @@
+#include <list_hooks.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+namespace {
+
+struct counted : unrolled_list_policy {
+    using hooks = counting_hooks;
+};
+
+struct timed : unrolled_list_policy {
+    using hooks = timing_hooks;
+};
+
+// Проверяет, что enter и leave приходят парами и правильно вложены.
+struct nesting_hooks {
+    std::vector<unrolled_list_event> stack;
+    bool balanced = true;
+
+    void enter(unrolled_list_event e) noexcept {
+        stack.push_back(e);
+    }
+    void leave(unrolled_list_event e, std::size_t) noexcept {
+        if (stack.empty() || stack.back() != e) {
+            balanced = false;
+            return;
+        }
+        stack.pop_back();
+    }
+};
+
+struct nested : unrolled_list_policy {
+    using hooks = nesting_hooks;
+};
+
+}
+
+/*
+    counting_hooks видит выделения и освобождения узлов, сдвиги в
+    push_front/pop_front, разбиения и очистку.
+*/
+TEST(Hooks, countingHooks) {
+    unrolled_list<int, 4, std::allocator<int>, counted> list;
+    for (int i = 0; i < 8; ++i) {
+        list.push_back(i);
+    }
+    list.push_front(-1);
+    list.push_front(-2);
+    list.insert(std::next(list.begin(), 5), 42);
+    list.pop_front();
+    list.clear();
+
+    const counting_hooks& h = list.hooks();
+    ASSERT_EQ(h.count(unrolled_list_event::node_allocate), 4);
+    ASSERT_EQ(h.count(unrolled_list_event::node_free), 4);
+    ASSERT_EQ(h.count(unrolled_list_event::split), 1);
+    ASSERT_EQ(h.amount(unrolled_list_event::split), 2);
+    ASSERT_EQ(h.count(unrolled_list_event::shift), 3);
+    ASSERT_EQ(h.amount(unrolled_list_event::shift), 3);
+    ASSERT_EQ(h.count(unrolled_list_event::clear), 1);
+    ASSERT_EQ(h.amount(unrolled_list_event::clear), 10);
+}
+
+/*
+    События вкладываются друг в друга: выделение узла внутри разбиения,
+    освобождения внутри очистки.
+*/
+TEST(Hooks, eventsNest) {
+    unrolled_list<int, 2, std::allocator<int>, nested> list;
+    for (int i = 0; i < 20; ++i) {
+        list.insert(list.begin(), i);
+        list.push_front(i);
+    }
+    list.erase(std::next(list.begin(), 3));
+    list.clear();
+    ASSERT_TRUE(list.hooks().balanced);
+    ASSERT_TRUE(list.hooks().stack.empty());
+}
+
+/*
+    timing_hooks раскладывает длительности событий по корзинам.
+*/
+TEST(Hooks, timingHooks) {
+    unrolled_list<int, 8, std::allocator<int>, timed> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.push_front(i);
+    }
+    const timing_hooks& h = list.hooks();
+    ASSERT_EQ(h.count(unrolled_list_event::node_allocate), 125);
+    ASSERT_EQ(h.count(unrolled_list_event::shift), 875);
+    ASSERT_GE(h.percentile(unrolled_list_event::shift, 0.99), h.percentile(unrolled_list_event::shift, 0.5));
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Элементы списка в обратном порядке, собранные операцией -- от последнего
+// элемента: так проверяется обратный обход через ссылки узлов.
+template<typename List>
+std::vector<int> backwards(const List& list) {
+    std::vector<int> result;
+    if (list.empty()) return result;
+    auto it = std::next(list.begin(), static_cast<std::ptrdiff_t>(list.size() - 1));
+    for (;;) {
+        result.push_back(*it);
+        if (it == list.begin()) break;
+        --it;
+    }
+    return result;
+}
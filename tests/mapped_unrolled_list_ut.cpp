@@ -0,0 +1,180 @@
+#include <mapped_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / (std::string(name) + std::to_string(::getpid()))).string();
+}
+
+template<typename Range>
+std::vector<int> to_vector(const Range& range) {
+    return std::vector<int>(range.begin(), range.end());
+}
+
+}
+
+/*
+    Содержимое переживает закрытие и повторное открытие файла,
+    в том числе после добавления сегментов.
+*/
+TEST(MappedUnrolledList, reopen) {
+    std::string path = temp_path("mapped_list_reopen");
+    std::remove(path.c_str());
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        ASSERT_TRUE(list.empty());
+        for (int i = 0; i < 5000; ++i) {
+            list.push_back(i);
+        }
+        list.push_front(-1);
+        list.sync();
+    }
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        ASSERT_EQ(list.size(), 5001);
+        ASSERT_EQ(list.front(), -1);
+        ASSERT_EQ(list.back(), 4999);
+        int expected = -1;
+        for (int v : list) {
+            ASSERT_EQ(v, expected++);
+        }
+        for (int i = 0; i < 4990; ++i) {
+            list.pop_back();
+        }
+        list.pop_front();
+    }
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        ASSERT_THAT(to_vector(list), testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+        ASSERT_EQ(list.node_count(), 3);
+    }
+    std::remove(path.c_str());
+}
+
+/*
+    Освобождённые слоты переиспользуются, и файл не растёт
+    при чередовании вставок и удалений.
+*/
+TEST(MappedUnrolledList, reusesSlots) {
+    std::string path = temp_path("mapped_list_reuse");
+    std::remove(path.c_str());
+    {
+        mapped_unrolled_list<int, 8> list(path);
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 2000; ++i) {
+                list.push_back(i);
+            }
+            ASSERT_EQ(list.node_count(), 250);
+            list.clear();
+            ASSERT_EQ(list.node_count(), 0);
+        }
+        list.push_back(1);
+        list.push_front(0);
+        ASSERT_THAT(to_vector(list), testing::ElementsAre(0, 1));
+        ASSERT_EQ(*--list.end(), 1);
+    }
+    ASSERT_LT(std::filesystem::file_size(path), 4096 + 2 * 512 * sizeof(int) * 16);
+    std::remove(path.c_str());
+}
+
+/*
+    Значение, ссылающееся на элемент списка, читается до роста файла
+    и до сдвига элементов головного узла.
+*/
+TEST(MappedUnrolledList, pushAliasedElement) {
+    std::string path = temp_path("mapped_list_alias");
+    std::remove(path.c_str());
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        // Ровно один заполненный сегмент: следующий узел требует роста файла.
+        for (int i = 0; i < 512 * 4; ++i) {
+            list.push_back(i);
+        }
+        list.push_back(list.front());
+        ASSERT_EQ(list.back(), 0);
+        ASSERT_EQ(list.size(), 512 * 4 + 1);
+    }
+    std::remove(path.c_str());
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        for (int i = 0; i < 512 * 4; ++i) {
+            list.push_back(i);
+        }
+        list.push_front(list.back());
+        ASSERT_EQ(list.front(), 512 * 4 - 1);
+        ASSERT_EQ(*++list.begin(), 0);
+    }
+    std::remove(path.c_str());
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        list.push_back(1);
+        list.push_back(2);
+        list.push_front(*++list.begin());
+        ASSERT_THAT(to_vector(list), testing::ElementsAre(2, 1, 2));
+    }
+    std::remove(path.c_str());
+}
+
+/*
+    Файл с другим типом элементов или размером узла не открывается.
+*/
+TEST(MappedUnrolledList, rejectsIncompatibleFile) {
+    std::string path = temp_path("mapped_list_layout");
+    std::remove(path.c_str());
+    {
+        mapped_unrolled_list<int, 4> list(path);
+        list.push_back(1);
+    }
+    using wrong_type = mapped_unrolled_list<long long, 4>;
+    using wrong_node = mapped_unrolled_list<int, 8>;
+    ASSERT_THROW(wrong_type{path}, std::runtime_error);
+    ASSERT_THROW(wrong_node{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
+
+/*
+    Файл с номерами head/tail за пределами сегментов или с непарными
+    head/tail считается повреждённым и не открывается.
+*/
+TEST(MappedUnrolledList, rejectsCorruptHeader) {
+    std::string path = temp_path("mapped_list_corrupt");
+    // Смещения полей head и tail в заголовке файла.
+    constexpr std::streamoff head_offset = 24;
+    constexpr std::streamoff tail_offset = 32;
+    auto patch = [&](std::streamoff offset, std::uint64_t value) {
+        std::remove(path.c_str());
+        {
+            mapped_unrolled_list<int, 4> list(path);
+            for (int i = 0; i < 10; ++i) {
+                list.push_back(i);
+            }
+        }
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(offset);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    using list_type = mapped_unrolled_list<int, 4>;
+
+    patch(head_offset, 1'000'000);
+    ASSERT_THROW(list_type{path}, std::runtime_error);
+    patch(tail_offset, 512);
+    ASSERT_THROW(list_type{path}, std::runtime_error);
+    patch(tail_offset, ~std::uint64_t{0});
+    ASSERT_THROW(list_type{path}, std::runtime_error);
+
+    patch(tail_offset, 2);
+    list_type list(path);
+    ASSERT_EQ(list.back(), 9);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,105 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+template<typename List>
+std::vector<typename List::value_type> to_vector(const List& list) {
+    return {list.begin(), list.end()};
+}
+
+/*
+    insert вставляет элемент перед pos, в том числе в заполненный узел,
+    который при этом делится пополам.
+*/
+TEST(Modifiers, insertBeforePosition) {
+    unrolled_list<int, 4> list = {0, 1, 2, 3, 4, 5};
+
+    auto it = list.insert(++list.begin(), 10);
+    ASSERT_EQ(*it, 10);
+    it = list.insert(list.begin(), 20);
+    ASSERT_EQ(*it, 20);
+    list.insert(list.end(), 30);
+    list.insert(++(++list.begin()), {40, 41});
+
+    ASSERT_THAT(to_vector(list), testing::ElementsAre(20, 0, 40, 41, 10, 1, 2, 3, 4, 5, 30));
+    ASSERT_EQ(list.size(), 11);
+}
+
+/*
+    Значение, ссылающееся на элемент заполненного узла,
+    копируется до разделения узла.
+*/
+TEST(Modifiers, insertAliasedElementIntoFullNode) {
+    const std::string tail = "long string to defeat small-buffer optimization";
+    unrolled_list<std::string, 4> list = {"a", "b", "c", tail};
+    list.insert(list.begin(), list.back());
+    list.insert(std::next(list.begin(), 3), list.front());
+    std::vector<std::string> values(list.begin(), list.end());
+    ASSERT_THAT(values, testing::ElementsAre(tail, "a", "b", tail, "c", tail));
+}
+
+/*
+    erase сдвигает оставшиеся элементы узла и возвращает итератор
+    на следующий элемент, удаление диапазона пересекает границы узлов.
+*/
+TEST(Modifiers, eraseKeepsOrder) {
+    unrolled_list<std::string, 3> list = {"a", "b", "c", "d", "e", "f", "g", "h"};
+
+    auto it = list.erase(++list.begin());
+    ASSERT_EQ(*it, "c");
+
+    auto first = list.begin();
+    std::advance(first, 2);
+    auto last = first;
+    std::advance(last, 3);
+    it = list.erase(first, last);
+    ASSERT_EQ(*it, "g");
+
+    ASSERT_THAT(to_vector(list), testing::ElementsAre("a", "c", "g", "h"));
+    ASSERT_EQ(list.size(), 4);
+
+    list.erase(list.begin(), list.end());
+    ASSERT_TRUE(list.empty());
+}
+
+/*
+    Итератор сверяется с текущим заполнением узла: после pop_back и erase
+    дальше в том же узле ++ переходит к следующему узлу или к end(),
+    а ++end() ничего не делает.
+*/
+TEST(Modifiers, incrementAfterNodeShrinks) {
+    unrolled_list<int, 4> list = {0, 1, 2, 3};
+    auto it = ++list.begin();
+    list.pop_back();
+    list.pop_back();
+    ++it;
+    ASSERT_TRUE(it == list.end());
+    ++it;
+    ASSERT_TRUE(it == list.end());
+
+    unrolled_list<int, 4> two_nodes = {0, 1, 2, 3, 4, 5, 6, 7};
+    auto pos = two_nodes.begin();
+    two_nodes.erase(std::next(two_nodes.begin(), 2), std::next(two_nodes.begin(), 4));
+    ++pos;
+    ++pos;
+    ASSERT_EQ(*pos, 4);
+    ASSERT_THAT(to_vector(two_nodes), testing::ElementsAre(0, 1, 4, 5, 6, 7));
+}
+
+/*
+    Пустой диапазон на end() ничего не удаляет и возвращает end(),
+    в том числе у пустого списка.
+*/
+TEST(Modifiers, eraseEmptyRangeAtEnd) {
+    unrolled_list<int, 4> list = {0, 1, 2, 3, 4};
+    ASSERT_TRUE(list.erase(list.end(), list.end()) == list.end());
+    ASSERT_THAT(to_vector(list), testing::ElementsAre(0, 1, 2, 3, 4));
+
+    unrolled_list<int, 4> empty;
+    ASSERT_TRUE(empty.erase(empty.begin(), empty.end()) == empty.end());
+    ASSERT_TRUE(empty.empty());
+}
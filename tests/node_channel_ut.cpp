@@ -0,0 +1,70 @@
+#include <node_channel.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    Потребитель получает узлы по порядку, полными, кроме последнего;
+    память ограничена очередью из max_in_flight узлов.
+*/
+TEST(NodeChannel, streamsFullNodes) {
+    constexpr int total = 10'000;
+    node_channel<int, 64> ch(2);
+    std::thread producer([&] {
+        for (int i = 0; i < total; ++i) {
+            ch.push(i);
+        }
+        ch.close();
+    });
+
+    int expected = 0;
+    std::vector<std::size_t> sizes;
+    for (auto&& batch : ch.batches()) {
+        sizes.push_back(batch.size());
+        for (int val : batch) {
+            ASSERT_EQ(val, expected++);
+        }
+    }
+    producer.join();
+
+    ASSERT_EQ(expected, total);
+    ASSERT_EQ(sizes.size(), (total + 63) / 64);
+    ASSERT_THAT(std::vector<std::size_t>(sizes.begin(), sizes.end() - 1), testing::Each(64));
+    ASSERT_EQ(sizes.back(), total % 64);
+    ASSERT_LE(ch.nodes_allocated(), 2 + 1 + 1);
+}
+
+/*
+    Элементы уничтожаются вместе с batch или с каналом; после закрытия
+    pop() возвращает пустой optional.
+*/
+TEST(NodeChannel, ownershipAndClose) {
+    node_channel<std::string, 4> ch(8);
+    for (int i = 0; i < 10; ++i) {
+        ch.push(std::string(40, static_cast<char>('a' + i)));
+    }
+    {
+        auto first = ch.pop();
+        ASSERT_TRUE(first.has_value());
+        ASSERT_EQ(first->size(), 4);
+        ASSERT_EQ(first->elements()[3], std::string(40, 'd'));
+    }
+    ch.close();
+    auto second = ch.pop();
+    auto third = ch.pop();
+    ASSERT_TRUE(second && third);
+    ASSERT_EQ(third->size(), 2);
+    ASSERT_EQ(*third->begin(), std::string(40, 'i'));
+    ASSERT_FALSE(ch.pop().has_value());
+    ASSERT_EQ(ch.nodes_allocated(), 3);
+
+    node_channel<std::string, 4> abandoned(8);
+    abandoned.push("left in the filling node");
+    for (int i = 0; i < 4; ++i) {
+        abandoned.push("left in the queue");
+    }
+}
@@ -0,0 +1,157 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "list_traversal.h"
+
+namespace {
+
+struct xor_policy : unrolled_list_policy {
+    static constexpr bool xor_links = true;
+};
+
+template<typename List>
+std::size_t bytes_per_node(const List& list) {
+    auto st = list.stats();
+    return st.bytes_allocated / st.nodes;
+}
+
+}
+
+/*
+    Число элементов узла хранится в наименьшем подходящем типе, а с xor_links
+    вместо двух указателей в заголовке остаётся один.
+*/
+TEST(NodeHeader, compactLayout) {
+    static_assert(std::is_same_v<unrolled_list_count_t<10>, std::uint8_t>);
+    static_assert(std::is_same_v<unrolled_list_count_t<255>, std::uint8_t>);
+    static_assert(std::is_same_v<unrolled_list_count_t<256>, std::uint16_t>);
+    static_assert(std::is_same_v<unrolled_list_count_t<70000>, std::uint32_t>);
+
+    unrolled_list<char, 7> narrow(7, 'x');
+    ASSERT_LT(bytes_per_node(narrow), 2 * sizeof(void*) + sizeof(std::size_t) + 7);
+
+    unrolled_list<int, 10> pair_links(std::size_t{10}, 1);
+    unrolled_list<int, 10, std::allocator<int>, xor_policy> xor_links(std::size_t{10}, 1);
+    ASSERT_EQ(bytes_per_node(xor_links), bytes_per_node(pair_links) - sizeof(void*));
+}
+
+/*
+    Со ссылками через xor список ведёт себя так же, как с обычными:
+    вставки и удаления в середине, с обоих концов, обход в обе стороны.
+*/
+TEST(NodeHeader, xorLinksMatchVector) {
+    unrolled_list<int, 4, std::allocator<int>, xor_policy> list;
+    std::vector<int> expected;
+    std::mt19937 gen(11);
+    for (int step = 0; step < 2000; ++step) {
+        std::size_t pos = gen() % (expected.size() + 1);
+        auto it = std::next(list.begin(), static_cast<std::ptrdiff_t>(pos));
+        switch (gen() % 6) {
+            case 0:
+            case 1: {
+                auto res = list.insert(it, step);
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), step);
+                ASSERT_EQ(*res, step);
+                break;
+            }
+            case 2:
+                if (pos < expected.size()) {
+                    auto res = list.erase(it);
+                    expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+                    ASSERT_EQ(std::distance(list.begin(), res), static_cast<std::ptrdiff_t>(pos));
+                }
+                break;
+            case 3:
+                list.push_front(step);
+                expected.insert(expected.begin(), step);
+                break;
+            case 4:
+                list.push_back(step);
+                expected.push_back(step);
+                break;
+            case 5:
+                if (!expected.empty()) {
+                    if (step % 2) {
+                        list.pop_front();
+                        expected.erase(expected.begin());
+                    } else {
+                        list.pop_back();
+                        expected.pop_back();
+                    }
+                }
+                break;
+        }
+        ASSERT_EQ(list.size(), expected.size());
+    }
+    ASSERT_EQ(std::vector<int>(list.begin(), list.end()), expected);
+    ASSERT_EQ(backwards(list), std::vector<int>(expected.rbegin(), expected.rend()));
+
+    std::stringstream ss;
+    list.serialize(ss);
+    unrolled_list<int, 4, std::allocator<int>, xor_policy> restored;
+    restored.deserialize(ss);
+    ASSERT_EQ(restored, list);
+}
+
+/*
+    Итератор, взятый до изменений, со ссылками prev/next переживает
+    разбиение предыдущего узла, удаление опустевшего предыдущего узла
+    и push_front нового первого узла: -- и ++ через границу узла идут
+    по текущим соседям.
+*/
+TEST(NodeHeader, pairLinksIteratorSurvivesNeighbourChanges) {
+    unrolled_list<int, 4> list = {0, 1, 2, 3, 4, 5, 6, 7};
+    auto it = std::next(list.begin(), 4);
+
+    list.insert(std::next(list.begin(), 1), 100);
+    auto before = it;
+    ASSERT_EQ(*--before, 3);
+
+    list.erase(std::next(list.begin(), 3), std::next(list.begin(), 5));
+    before = it;
+    ASSERT_EQ(*--before, 1);
+
+    unrolled_list<int, 4> front_list = {0, 1, 2, 3};
+    auto first = front_list.begin();
+    front_list.push_front(-1);
+    before = first;
+    ASSERT_EQ(*--before, -1);
+    ASSERT_EQ(std::vector<int>(first, front_list.end()), std::vector<int>({0, 1, 2, 3}));
+
+    ASSERT_EQ(std::vector<int>(it, list.end()), std::vector<int>({4, 5, 6, 7}));
+    ASSERT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({0, 100, 1, 4, 5, 6, 7}));
+}
+
+/*
+    С xor_links итератор помнит предыдущий узел, поэтому переживает
+    изменения всех узлов, кроме предыдущего: разбиение своего и следующих
+    узлов, удаление опустевших узлов дальше по списку, push_back и
+    push_front, если первый узел не предыдущий.
+*/
+TEST(NodeHeader, xorLinksIteratorSurvivesChangesAwayFromPrevious) {
+    unrolled_list<int, 4, std::allocator<int>, xor_policy> list = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    auto it = std::next(list.begin(), 8);
+
+    list.insert(std::next(list.begin(), 10), 100);
+    list.push_back(12);
+    list.push_back(13);
+    list.push_back(14);
+    ASSERT_EQ(list.stats().nodes, 5);
+    list.erase(std::next(list.begin(), 10), list.end());
+    ASSERT_EQ(list.stats().nodes, 3);
+    list.push_front(-1);
+    list.insert(std::next(list.begin(), 2), 200);
+
+    auto before = it;
+    ASSERT_EQ(*--before, 7);
+    ASSERT_EQ(std::vector<int>(it, list.end()), std::vector<int>({8, 9}));
+    ASSERT_EQ(std::vector<int>(list.begin(), list.end()),
+              std::vector<int>({-1, 0, 200, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ASSERT_EQ(backwards(list), std::vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1, 200, 0, -1}));
+}
@@ -0,0 +1,207 @@
+#include <list_hooks.h>
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include "list_traversal.h"
+
+namespace {
+
+struct pooled_policy : unrolled_list_policy {
+    static constexpr bool node_pool = true;
+    static constexpr bool count_operations = true;
+};
+
+struct pooled_hooked_policy : pooled_policy {
+    using hooks = counting_hooks;
+};
+
+struct pooled_xor_policy : pooled_policy {
+    static constexpr bool xor_links = true;
+};
+
+struct tracked {
+    static inline int alive = 0;
+
+    int value;
+
+    tracked(int v) : value(v) {
+        ++alive;
+    }
+    tracked(const tracked& other) : value(other.value) {
+        ++alive;
+    }
+    ~tracked() {
+        --alive;
+    }
+};
+
+template<typename List>
+std::vector<int> contents(const List& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+}
+
+/*
+    clear() отдаёт узлы пулу, и следующее заполнение обходится без
+    обращений к аллокатору.
+*/
+TEST(NodePool, clearReusesNodes) {
+    unrolled_list<int, 4, std::allocator<int>, pooled_policy> list;
+    for (int i = 0; i < 20; ++i) {
+        list.push_back(i);
+    }
+    ASSERT_EQ(list.stats().counters.allocations, 5);
+
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.pooled_node_count(), 5);
+    ASSERT_EQ(list.stats().counters.frees, 0);
+
+    for (int i = 0; i < 20; ++i) {
+        list.push_back(i * 2);
+    }
+    ASSERT_EQ(list.stats().counters.allocations, 5);
+    ASSERT_EQ(list.pooled_node_count(), 0);
+    ASSERT_EQ(list.front(), 0);
+    ASSERT_EQ(list.back(), 38);
+    ASSERT_EQ(list.size(), 20);
+}
+
+/*
+    Узлы, освобождённые pop_back, pop_front и erase, тоже попадают в пул;
+    release_node_pool() возвращает их аллокатору.
+*/
+TEST(NodePool, singleNodesAndRelease) {
+    unrolled_list<int, 2, std::allocator<int>, pooled_policy> list = {1, 2, 3, 4, 5, 6};
+    list.pop_back();
+    list.pop_back();
+    list.pop_front();
+    list.pop_front();
+    ASSERT_EQ(list.pooled_node_count(), 2);
+    ASSERT_THAT(contents(list), testing::ElementsAre(3, 4));
+
+    list.push_front(0);
+    ASSERT_EQ(list.pooled_node_count(), 1);
+    ASSERT_THAT(contents(list), testing::ElementsAre(0, 3, 4));
+
+    list.release_node_pool();
+    ASSERT_EQ(list.pooled_node_count(), 0);
+    ASSERT_EQ(list.stats().counters.frees, 1);
+    ASSERT_THAT(contents(list), testing::ElementsAre(0, 3, 4));
+}
+
+/*
+    С xor_links пул связан тем же единственным словом; узлы из него
+    правильно встают в обе стороны списка.
+*/
+TEST(NodePool, xorLinks) {
+    unrolled_list<int, 3, std::allocator<int>, pooled_xor_policy> list;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 9; ++i) {
+            list.push_back(i);
+        }
+        list.pop_front();
+        list.pop_front();
+        list.pop_front();
+        list.push_front(-1);
+        ASSERT_THAT(contents(list), testing::ElementsAre(-1, 3, 4, 5, 6, 7, 8));
+        ASSERT_THAT(backwards(list), testing::ElementsAre(8, 7, 6, 5, 4, 3, -1));
+        list.clear();
+    }
+    ASSERT_EQ(list.stats().counters.allocations, 3);
+    ASSERT_EQ(list.pooled_node_count(), 3);
+}
+
+/*
+    Нетривиальные элементы по-прежнему разрушаются при clear() с пулом
+    и без него.
+*/
+TEST(NodePool, destroysNonTrivialElements) {
+    {
+        unrolled_list<tracked, 4, std::allocator<tracked>, pooled_policy> pooled;
+        unrolled_list<tracked, 4> plain;
+        for (int i = 0; i < 10; ++i) {
+            pooled.push_back(tracked(i));
+            plain.push_back(tracked(i));
+        }
+        ASSERT_EQ(tracked::alive, 20);
+        pooled.clear();
+        plain.clear();
+        ASSERT_EQ(tracked::alive, 0);
+        pooled.push_back(tracked(1));
+    }
+    ASSERT_EQ(tracked::alive, 0);
+
+    unrolled_list<std::string, 4, std::allocator<std::string>, pooled_policy> strings;
+    for (int i = 0; i < 10; ++i) {
+        strings.push_back(std::string(64, static_cast<char>('a' + i)));
+    }
+    strings.clear();
+    strings.push_back("x");
+    ASSERT_EQ(strings.front(), "x");
+}
+
+/*
+    swap и перемещающее присваивание не смешивают пулы разных списков.
+*/
+TEST(NodePool, swapAndMove) {
+    using list_type = unrolled_list<int, 2, std::allocator<int>, pooled_policy>;
+    list_type a = {1, 2, 3, 4};
+    list_type b = {5};
+    a.clear();
+    a.swap(b);
+    ASSERT_EQ(a.pooled_node_count(), 0);
+    ASSERT_EQ(b.pooled_node_count(), 2);
+    ASSERT_THAT(contents(a), testing::ElementsAre(5));
+
+    b = std::move(a);
+    ASSERT_EQ(b.pooled_node_count(), 0);
+    ASSERT_THAT(contents(b), testing::ElementsAre(5));
+}
+
+/*
+    Хуки и счётчики видят только обращения к аллокатору: узлы,
+    взятые из пула или возвращённые в него, не учитываются.
+*/
+TEST(NodePool, hooksCountAllocatorCallsOnly) {
+    unrolled_list<int, 4, std::allocator<int>, pooled_hooked_policy> list;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 12; ++i) {
+            list.push_back(i);
+        }
+        list.clear();
+    }
+    const counting_hooks& h = list.hooks();
+    ASSERT_EQ(h.count(unrolled_list_event::node_allocate), 3);
+    ASSERT_EQ(h.count(unrolled_list_event::node_free), 0);
+    ASSERT_EQ(list.stats().counters.allocations, 3);
+    ASSERT_EQ(list.stats().counters.frees, 0);
+
+    list.release_node_pool();
+    ASSERT_EQ(h.count(unrolled_list_event::node_free), 3);
+    ASSERT_EQ(list.stats().counters.frees, 3);
+}
+
+/*
+    Перемещающий конструктор забирает пул вместе с узлами.
+*/
+TEST(NodePool, moveConstructorTakesPool) {
+    using list_type = unrolled_list<int, 2, std::allocator<int>, pooled_policy>;
+    list_type a = {1, 2, 3, 4, 5};
+    a.pop_front();
+    a.pop_front();
+    ASSERT_EQ(a.pooled_node_count(), 1);
+
+    list_type b(std::move(a));
+    ASSERT_EQ(a.pooled_node_count(), 0);
+    ASSERT_EQ(b.pooled_node_count(), 1);
+    b.push_front(0);
+    ASSERT_EQ(b.pooled_node_count(), 0);
+    ASSERT_THAT(contents(b), testing::ElementsAre(0, 3, 4, 5));
+}
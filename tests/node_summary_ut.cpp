@@ -0,0 +1,103 @@
+#include <unrolled_list.h>
+#include <node_summary.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+namespace {
+
+struct Record {
+    int    Id;
+    double Price;
+};
+
+struct price_of {
+    double operator()(const Record& r) const noexcept {
+        return r.Price;
+    }
+};
+
+struct id_of {
+    int operator()(const Record& r) const noexcept {
+        return r.Id;
+    }
+};
+
+struct by_price : unrolled_list_policy {
+    using summary = minmax_summary<double, price_of>;
+};
+
+struct by_id : unrolled_list_policy {
+    using summary = bloom_summary<int, id_of, 256>;
+};
+
+}
+
+/*
+    Сводка min/max по цене позволяет пропустить узлы, чей диапазон цен
+    не пересекается с запрошенным, не потеряв ни одного подходящего элемента.
+*/
+TEST(NodeSummary, minmaxSkipsNodes) {
+    unrolled_list<Record, 10, std::allocator<Record>, by_price> list;
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(Record{i, static_cast<double>(i)});
+    }
+
+    std::vector<int> ids;
+    auto stats = list.scan(
+        [](const Record& r) { return r.Price >= 42 && r.Price <= 47; },
+        [](const auto& s) { return s.may_intersect(42, 47); },
+        [&](const Record& r) { ids.push_back(r.Id); });
+
+    ASSERT_THAT(ids, testing::ElementsAre(42, 43, 44, 45, 46, 47));
+    ASSERT_EQ(stats.matches, 6);
+    ASSERT_EQ(stats.nodes_scanned, 1);
+    ASSERT_EQ(stats.nodes_skipped, 9);
+}
+
+/*
+    Сводки поддерживаются при вставке в середину, разбиении узла и удалении:
+    после удаления крайнего значения узел снова может быть пропущен.
+*/
+TEST(NodeSummary, maintainedOnInsertAndErase) {
+    unrolled_list<Record, 4, std::allocator<Record>, by_price> list;
+    for (int i = 0; i < 8; ++i) {
+        list.push_back(Record{i, 10.0 + i});
+    }
+
+    auto it = list.insert(++list.begin(), Record{100, 500.0});
+    auto in_range = [](const Record& r) { return r.Price > 400; };
+    auto may_hold = [](const auto& s) { return s.may_intersect(400, 1000); };
+
+    auto stats = list.scan(in_range, may_hold);
+    ASSERT_EQ(stats.matches, 1);
+    ASSERT_EQ(stats.nodes_scanned, 1);
+    ASSERT_EQ(stats.nodes_skipped, 2);
+
+    list.erase(it);
+    stats = list.scan(in_range, may_hold);
+    ASSERT_EQ(stats.matches, 0);
+    ASSERT_EQ(stats.nodes_scanned, 0);
+    ASSERT_EQ(stats.nodes_skipped, 3);
+}
+
+/*
+    Фильтр Блума не даёт ложноотрицательных ответов и отсекает узлы
+    для отсутствующих ключей.
+*/
+TEST(NodeSummary, bloomFindsEveryKey) {
+    unrolled_list<Record, 16, std::allocator<Record>, by_id> list;
+    for (int i = 0; i < 160; ++i) {
+        list.push_back(Record{i * 7, 0.0});
+    }
+
+    for (int key = 0; key < 160 * 7; key += 7) {
+        auto stats = list.scan(
+            [key](const Record& r) { return r.Id == key; },
+            [key](const auto& s) { return s.may_contain(key); });
+        ASSERT_EQ(stats.matches, 1);
+        ASSERT_LT(stats.nodes_scanned, 5);
+    }
+}
@@ -0,0 +1,87 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct xor_policy : unrolled_list_policy {
+    static constexpr bool xor_links = true;
+};
+
+template<typename List>
+void check_against_vector(unsigned seed) {
+    List list;
+    std::vector<int> expected;
+    std::mt19937 gen(seed);
+    for (int i = 0; i < 300; ++i) {
+        list.push_back(i);
+        expected.push_back(i);
+    }
+    std::size_t cursor = 0;
+    for (int step = 0; step < 5000; ++step) {
+        unsigned op = gen() % 10;
+        if (op < 6) {
+            // «k, потом k + 1, потом k + 3» с редкими прыжками
+            cursor = op == 0 ? gen() % expected.size() : (cursor + gen() % 4) % expected.size();
+            ASSERT_EQ(list[cursor], expected[cursor]);
+            const List& cref = list;
+            std::size_t back = cursor >= 5 ? cursor - 5 : 0;
+            ASSERT_EQ(cref[back], expected[back]);
+        } else if (op == 6) {
+            std::size_t pos = gen() % (expected.size() + 1);
+            list.insert(list.nth(pos), -step);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), -step);
+        } else if (op == 7 && expected.size() > 1) {
+            std::size_t pos = gen() % expected.size();
+            list.erase(list.nth(pos));
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+        } else if (op == 8) {
+            list.push_front(step);
+            expected.insert(expected.begin(), step);
+        } else if (expected.size() > 1) {
+            list.pop_back();
+            expected.pop_back();
+        }
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(list.at(i), expected[i]);
+    }
+}
+
+}
+
+/*
+    operator[], at() и nth() совпадают с std::vector при любой смеси
+    обращений по номеру, вставок и удалений, сбрасывающих палец.
+*/
+TEST(PositionalAccess, matchesVector) {
+    check_against_vector<unrolled_list<int, 8>>(1);
+    check_against_vector<unrolled_list<int, 8, std::allocator<int>, xor_policy>>(2);
+}
+
+/*
+    nth() даёт полноценный итератор, в том числе для шага назад,
+    а за пределами размера — end() и исключение из at().
+*/
+TEST(PositionalAccess, nthAndBounds) {
+    unrolled_list<int, 4, std::allocator<int>, xor_policy> list = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    list[7] = 70;
+    auto it = list.nth(5);
+    ASSERT_EQ(*it, 5);
+    --it;
+    --it;
+    ASSERT_EQ(*it, 3);
+    ASSERT_EQ(*std::next(list.nth(6)), 70);
+    ASSERT_EQ(list.nth(10), list.end());
+    ASSERT_THROW(list.at(10), std::out_of_range);
+
+    decltype(list) other = {1, 2};
+    other[1] = 5;
+    list.swap(other);
+    ASSERT_EQ(list[1], 5);
+    ASSERT_EQ(other[7], 70);
+}
@@ -0,0 +1,131 @@
+#include <rcu_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Tracked {
+    static inline int Alive = 0;
+
+    int Value = 0;
+
+    Tracked(int v) : Value(v) { ++Alive; }
+    Tracked(const Tracked& other) : Value(other.Value) { ++Alive; }
+    ~Tracked() { --Alive; }
+};
+
+template<typename List>
+std::vector<int> collect(const List& list) {
+    std::vector<int> result;
+    auto guard = list.read_lock();
+    for (const auto& x : guard) {
+        result.push_back(static_cast<int>(x));
+    }
+    return result;
+}
+
+}
+
+/*
+    Операции писателя сохраняют порядок элементов, в том числе при
+    вставке в заполненный узел, который делится на два.
+*/
+TEST(RcuUnrolledList, writerOperations) {
+    rcu_unrolled_list<int, 4> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    list.insert(2, 100);
+    list.insert(9, 200);
+    list.push_front(-1);
+    list.erase(5);
+    list.pop_front();
+
+    ASSERT_EQ(list.size(), 11);
+    ASSERT_THAT(collect(list), testing::ElementsAre(0, 1, 100, 2, 4, 5, 6, 7, 200, 8, 9));
+
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    ASSERT_TRUE(collect(list).empty());
+}
+
+/*
+    Пока читатель держит read_guard, вытесненный узел не освобождается
+    и читатель продолжает видеть прежнее содержимое.
+*/
+TEST(RcuUnrolledList, retiredNodesOutliveReaders) {
+    Tracked::Alive = 0;
+    {
+        rcu_unrolled_list<Tracked, 4> list;
+        for (int i = 0; i < 4; ++i) {
+            list.push_back(Tracked(i));
+        }
+        ASSERT_EQ(Tracked::Alive, 4);
+
+        {
+            auto guard = list.read_lock();
+            auto it = guard.begin();
+            list.erase(1);
+            ASSERT_EQ(list.reclaim(), 0);
+            ASSERT_EQ(list.retired_count(), 1);
+
+            std::vector<int> seen;
+            for (; it != guard.end(); ++it) {
+                seen.push_back(it->Value);
+            }
+            ASSERT_THAT(seen, testing::ElementsAre(0, 1, 2, 3));
+        }
+
+        ASSERT_EQ(list.reclaim(), 1);
+        ASSERT_EQ(list.retired_count(), 0);
+        ASSERT_EQ(Tracked::Alive, 3);
+    }
+    ASSERT_EQ(Tracked::Alive, 0);
+}
+
+/*
+    Читатели обходят список параллельно с писателем. Писатель добавляет
+    возрастающие значения и удаляет случайные позиции, поэтому каждый
+    обход обязан видеть строго возрастающую последовательность.
+*/
+TEST(RcuUnrolledList, concurrentReaders) {
+    rcu_unrolled_list<int, 8> list;
+    std::atomic<bool> done = false;
+    std::atomic<bool> failed = false;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto guard = list.read_lock();
+                int prev = -1;
+                for (int x : guard) {
+                    if (x <= prev) failed = true;
+                    prev = x;
+                }
+            }
+        });
+    }
+
+    unsigned seed = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        list.push_back(i);
+        seed = seed * 1103515245 + 12345;
+        if (i % 3 == 0 && list.size() > 1) {
+            list.erase((seed >> 8) % list.size());
+        }
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    list.synchronize();
+
+    ASSERT_FALSE(failed.load());
+    ASSERT_EQ(list.retired_count(), 0);
+}
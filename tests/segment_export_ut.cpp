@@ -0,0 +1,67 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+/*
+    Сегменты покрывают storage узлов по порядку и без копирования.
+*/
+TEST(SegmentExport, segmentsCoverNodes) {
+    unrolled_list<std::uint32_t, 4> list;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+
+    std::vector<std::size_t> sizes;
+    std::vector<std::uint32_t> values;
+    list.for_each_segment([&](std::span<const std::byte> seg) {
+        sizes.push_back(seg.size());
+        const std::uint32_t* p = reinterpret_cast<const std::uint32_t*>(seg.data());
+        values.insert(values.end(), p, p + seg.size() / sizeof(std::uint32_t));
+    });
+    ASSERT_THAT(sizes, testing::ElementsAre(16, 16, 8));
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), list.begin(), list.end()));
+
+    std::vector<iovec> vecs;
+    ASSERT_EQ(list.export_iovecs(vecs), 40);
+    ASSERT_EQ(vecs.size(), 3);
+    ASSERT_EQ(vecs.front().iov_base, static_cast<const void*>(&list.front()));
+}
+
+/*
+    write_fd отправляет в канал весь список, даже когда он не помещается
+    в буфер канала и writev пишет его частями.
+*/
+TEST(SegmentExport, writeToPipe) {
+    unrolled_list<std::uint64_t, 7> list;
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        list.push_back(i * 3);
+    }
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    std::vector<std::uint64_t> received(list.size());
+    std::thread reader([&] {
+        char* dst = reinterpret_cast<char*>(received.data());
+        std::size_t left = received.size() * sizeof(std::uint64_t);
+        while (left > 0) {
+            ssize_t got = ::read(fds[0], dst, left);
+            if (got <= 0) break;
+            dst += got;
+            left -= static_cast<std::size_t>(got);
+        }
+    });
+    std::size_t written = list.write_fd(fds[1]);
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    ASSERT_EQ(written, list.size() * sizeof(std::uint64_t));
+    ASSERT_TRUE(std::equal(received.begin(), received.end(), list.begin(), list.end()));
+}
@@ -0,0 +1,108 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Point {
+    int    X;
+    double Y;
+
+    bool operator==(const Point&) const = default;
+};
+
+struct Named {
+    std::string Name;
+
+    bool operator==(const Named&) const = default;
+};
+
+}
+
+template<>
+struct unrolled_list_serializer<Named> {
+    template<typename Out>
+    static void write(Out& out, const Named& val) {
+        std::uint32_t len = static_cast<std::uint32_t>(val.Name.size());
+        out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.write(val.Name.data(), len);
+    }
+    template<typename In>
+    static Named read(In& in) {
+        std::uint32_t len = 0;
+        in.read(reinterpret_cast<char*>(&len), sizeof(len));
+        std::string name(len, '\0');
+        in.read(name.data(), len);
+        return Named{std::move(name)};
+    }
+};
+
+/*
+    Тривиально копируемые элементы проходят круг сериализации через поток
+    и через буфер; читать можно в список с другим NodeMaxSize.
+*/
+TEST(Serialization, trivialRoundTrip) {
+    unrolled_list<Point, 4> list;
+    for (int i = 0; i < 11; ++i) {
+        list.push_back(Point{i, i * 0.5});
+    }
+
+    std::stringstream stream;
+    list.serialize(stream);
+    unrolled_list<Point, 4> from_stream;
+    from_stream.deserialize(stream);
+    ASSERT_EQ(from_stream, list);
+
+    std::vector<std::byte> buffer;
+    list.serialize(buffer);
+    unrolled_list<Point, 3> from_buffer;
+    from_buffer.deserialize(buffer);
+    ASSERT_EQ(from_buffer.size(), 11);
+    ASSERT_TRUE(std::equal(list.begin(), list.end(), from_buffer.begin()));
+}
+
+/*
+    Для нетривиальных типов используется unrolled_list_serializer.
+*/
+TEST(Serialization, customSerializer) {
+    unrolled_list<Named, 2> list = {Named{"alpha"}, Named{""}, Named{"gamma"}};
+
+    std::vector<std::byte> buffer;
+    list.serialize(buffer);
+    unrolled_list<Named, 2> restored;
+    restored.deserialize(buffer);
+    ASSERT_EQ(restored, list);
+
+    std::stringstream stream;
+    list.serialize(stream);
+    restored.clear();
+    restored.deserialize(stream);
+    ASSERT_EQ(restored, list);
+}
+
+/*
+    Повреждённый или обрезанный ввод приводит к исключению,
+    а содержимое списка не меняется.
+*/
+TEST(Serialization, rejectsBadInput) {
+    unrolled_list<int, 4> list = {1, 2, 3, 4, 5};
+    std::vector<std::byte> buffer;
+    list.serialize(buffer);
+
+    unrolled_list<int, 4> target = {42};
+    std::vector<std::byte> truncated(buffer.begin(), buffer.end() - 3);
+    ASSERT_THROW(target.deserialize(truncated), std::runtime_error);
+    ASSERT_THAT(std::vector<int>(target.begin(), target.end()), testing::ElementsAre(42));
+
+    std::vector<std::byte> corrupted = buffer;
+    corrupted[0] = std::byte{0};
+    ASSERT_THROW(target.deserialize(corrupted), std::runtime_error);
+
+    unrolled_list<long long, 4> wrong_type;
+    ASSERT_THROW(wrong_type.deserialize(buffer), std::runtime_error);
+}
@@ -0,0 +1,78 @@
+#include <sharded_appender.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct xor_policy : unrolled_list_policy {
+    static constexpr bool xor_links = true;
+};
+
+}
+
+/*
+    splice_back переносит узлы целиком: неполный последний узел остаётся
+    в середине, а список дальше работает как обычно.
+*/
+TEST(ShardedAppender, spliceBack) {
+    unrolled_list<int, 4> a = {1, 2, 3, 4, 5};
+    unrolled_list<int, 4> b = {6, 7};
+    unrolled_list<int, 4> empty;
+    a.splice_back(std::move(empty));
+    a.splice_back(std::move(b));
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(a.size(), 7);
+    ASSERT_EQ(a.stats().nodes, 3);
+    ASSERT_THAT(a, testing::ElementsAre(1, 2, 3, 4, 5, 6, 7));
+
+    a.insert(std::next(a.begin(), 5), 42);
+    a.pop_back();
+    empty.splice_back(std::move(a));
+    ASSERT_THAT(empty, testing::ElementsAre(1, 2, 3, 4, 5, 42, 6));
+
+    unrolled_list<int, 4, std::allocator<int>, xor_policy> x = {1, 2, 3};
+    unrolled_list<int, 4, std::allocator<int>, xor_policy> y = {4, 5, 6, 7, 8};
+    x.splice_back(std::move(y));
+    ASSERT_THAT(x, testing::ElementsAre(1, 2, 3, 4, 5, 6, 7, 8));
+    auto it = std::next(x.begin(), 7);
+    for (int expected = 8; expected > 1; --expected) {
+        ASSERT_EQ(*it, expected);
+        --it;
+    }
+}
+
+/*
+    Потоки пишут каждый в свой шард, collect() сцепляет их по порядку номеров.
+*/
+TEST(ShardedAppender, collectInShardOrder) {
+    constexpr int threads = 4;
+    constexpr int per_thread = 1000;
+    sharded_appender<int, 16> out(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&out, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                out.shard(t).push_back(t * per_thread + i);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    unrolled_list<int, 16> all = out.collect();
+    ASSERT_EQ(all.size(), threads * per_thread);
+    int expected = 0;
+    for (int val : all) {
+        ASSERT_EQ(val, expected++);
+    }
+    for (int t = 0; t < threads; ++t) {
+        ASSERT_TRUE(out.shard(t).empty());
+    }
+    out.shard(1).push_back(-1);
+    ASSERT_THAT(out.collect(), testing::ElementsAre(-1));
+}
@@ -0,0 +1,99 @@
+#include <soa_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+struct Order {
+    std::uint64_t Id;
+    double        Price;
+    std::uint32_t Qty;
+
+    bool operator==(const Order&) const = default;
+};
+
+using order_list = soa_unrolled_list<Order, 4, &Order::Id, &Order::Price, &Order::Qty>;
+
+std::vector<Order> to_vector(const order_list& list) {
+    std::vector<Order> result;
+    for (Order o : list) {
+        result.push_back(o);
+    }
+    return result;
+}
+
+}
+
+/*
+    Элементы собираются из столбцов обратно в исходном порядке,
+    в том числе после вставок и удалений с обоих концов.
+*/
+TEST(SoaUnrolledList, roundTrip) {
+    order_list list;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+        list.push_back(Order{i, i * 1.5, i * 10});
+    }
+    list.push_front(Order{100, 0.25, 7});
+    list.pop_back();
+    list.pop_front();
+    list.pop_front();
+
+    ASSERT_EQ(list.size(), 8);
+    std::vector<Order> expected;
+    for (std::uint32_t i = 1; i < 9; ++i) {
+        expected.push_back(Order{i, i * 1.5, i * 10});
+    }
+    ASSERT_EQ(to_vector(list), expected);
+    ASSERT_EQ(static_cast<Order>(list.front()), expected.front());
+    ASSERT_EQ(list.back().get<&Order::Qty>(), 80);
+
+    order_list copy = list;
+    list.clear();
+    ASSERT_EQ(to_vector(copy), expected);
+}
+
+/*
+    Прокси-ссылка даёт доступ к отдельным полям и записывает элемент
+    целиком; присваивание одной ссылки другой копирует значение.
+*/
+TEST(SoaUnrolledList, proxyReference) {
+    order_list list = {Order{1, 1.0, 1}, Order{2, 2.0, 2}, Order{3, 3.0, 3}};
+    auto it = list.begin();
+    (*it).get<&Order::Price>() = 9.5;
+    ++it;
+    *it = Order{20, 20.0, 20};
+    auto last = std::next(it);
+    *last = *list.begin();
+
+    ASSERT_THAT(to_vector(list), testing::ElementsAre(
+        Order{1, 9.5, 1}, Order{20, 20.0, 20}, Order{1, 9.5, 1}));
+}
+
+/*
+    Проход по столбцу видит только заполненную часть каждого узла.
+*/
+TEST(SoaUnrolledList, columnSegments) {
+    order_list list;
+    for (std::uint32_t i = 0; i < 11; ++i) {
+        list.push_back(Order{i, 0.5 * i, i});
+    }
+
+    std::vector<std::size_t> sizes;
+    double total = 0;
+    list.for_each_segment<&Order::Price>([&](std::span<const double> prices) {
+        sizes.push_back(prices.size());
+        total = std::accumulate(prices.begin(), prices.end(), total);
+    });
+    ASSERT_THAT(sizes, testing::ElementsAre(4, 4, 3));
+    ASSERT_DOUBLE_EQ(total, 0.5 * 55);
+
+    list.for_each_segment_mut<&Order::Qty>([](std::span<std::uint32_t> qty) {
+        for (std::uint32_t& q : qty) q *= 2;
+    });
+    ASSERT_EQ(list.back().get<&Order::Qty>(), 20);
+}
@@ -0,0 +1,100 @@
+#include <sorted_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+    Элементы всегда упорядочены, в том числе после разбиения узлов
+    и удаления.
+*/
+TEST(SortedUnrolledList, keepsOrder) {
+    sorted_unrolled_list<int, std::less<int>, 4> list = {5, 1, 9, 3, 7, 3, 8, 2, 6, 4, 0};
+    ASSERT_THAT(std::vector<int>(list.begin(), list.end()),
+                testing::ElementsAre(0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9));
+    ASSERT_GE(list.node_count(), 3);
+
+    ASSERT_EQ(list.erase(3), 2);
+    ASSERT_EQ(list.erase(42), 0);
+    ASSERT_THAT(std::vector<int>(list.begin(), list.end()),
+                testing::ElementsAre(0, 1, 2, 4, 5, 6, 7, 8, 9));
+    ASSERT_EQ(list.front(), 0);
+    ASSERT_EQ(list.back(), 9);
+}
+
+/*
+    Пользовательский компаратор задаёт порядок, а равные ключи
+    остаются в порядке вставки.
+*/
+TEST(SortedUnrolledList, customCompareIsStable) {
+    using pair_type = std::pair<int, int>;
+    auto by_first = [](const pair_type& a, const pair_type& b) { return a.first > b.first; };
+    sorted_unrolled_list<pair_type, decltype(by_first), 3> list(by_first);
+    for (int i = 0; i < 12; ++i) {
+        list.insert({i % 4, i});
+    }
+
+    std::vector<pair_type> result(list.begin(), list.end());
+    ASSERT_THAT(result, testing::ElementsAre(
+        pair_type{3, 3}, pair_type{3, 7}, pair_type{3, 11},
+        pair_type{2, 2}, pair_type{2, 6}, pair_type{2, 10},
+        pair_type{1, 1}, pair_type{1, 5}, pair_type{1, 9},
+        pair_type{0, 0}, pair_type{0, 4}, pair_type{0, 8}));
+
+    auto [first, last] = list.equal_range({2, 0});
+    ASSERT_EQ(std::distance(first, last), 3);
+    ASSERT_EQ(first->second, 2);
+}
+
+/*
+    Случайные вставки и удаления сверяются с std::multiset: совпадают
+    содержимое и результаты lower_bound, upper_bound и count.
+*/
+TEST(SortedUnrolledList, matchesMultiset) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> value(0, 500);
+    sorted_unrolled_list<int, std::less<int>, 8> list;
+    std::multiset<int> reference;
+
+    for (int step = 0; step < 5000; ++step) {
+        int v = value(rng);
+        if (step % 3 == 2) {
+            ASSERT_EQ(list.erase(v), reference.erase(v));
+        } else {
+            ASSERT_EQ(*list.insert(v), v);
+            reference.insert(v);
+        }
+    }
+    ASSERT_EQ(list.size(), reference.size());
+    ASSERT_TRUE(std::equal(list.begin(), list.end(), reference.begin(), reference.end()));
+
+    for (int key = -1; key <= 501; ++key) {
+        ASSERT_EQ(std::distance(list.begin(), list.lower_bound(key)),
+                  std::distance(reference.begin(), reference.lower_bound(key)));
+        ASSERT_EQ(std::distance(list.begin(), list.upper_bound(key)),
+                  std::distance(reference.begin(), reference.upper_bound(key)));
+        ASSERT_EQ(list.count(key), reference.count(key));
+        ASSERT_EQ(list.contains(key), reference.contains(key));
+    }
+}
+
+/*
+    Значение, ссылающееся на элемент заполненного узла,
+    копируется до разделения узла, и порядок сохраняется.
+*/
+TEST(SortedUnrolledList, insertAliasedElementIntoFullNode) {
+    const std::string last = "z: long string to defeat small-buffer optimization";
+    sorted_unrolled_list<std::string, std::less<>, 4> list;
+    for (const char* value : {"a", "b", "c"}) {
+        list.insert(value);
+    }
+    list.insert(last);
+    list.insert(list.back());
+    std::vector<std::string> values(list.begin(), list.end());
+    ASSERT_THAT(values, testing::ElementsAre("a", "b", "c", last, last));
+}
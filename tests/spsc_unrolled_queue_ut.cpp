@@ -0,0 +1,168 @@
+#include <spsc_unrolled_queue.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+#include <vector>
+
+template<typename T>
+class CountingAllocator {
+public:
+    using value_type = T;
+
+    static inline int AllocationCount = 0;
+    static inline int DeallocationCount = 0;
+
+    CountingAllocator() = default;
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        ++CountingAllocator<char>::AllocationCount;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        ++CountingAllocator<char>::DeallocationCount;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const CountingAllocator&) const {
+        return true;
+    }
+};
+
+struct Tracked {
+    static inline int Alive = 0;
+
+    int Value = 0;
+
+    Tracked(int v) : Value(v) { ++Alive; }
+    Tracked(const Tracked& other) : Value(other.Value) { ++Alive; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { --Alive; }
+};
+
+/*
+    Элементы выходят в порядке добавления, в том числе через границы узлов.
+*/
+TEST(SpscUnrolledQueue, fifoAcrossNodes) {
+    spsc_unrolled_queue<int, 4> queue;
+    ASSERT_TRUE(queue.empty());
+
+    for (int i = 0; i < 11; ++i) {
+        queue.push(i);
+    }
+    ASSERT_FALSE(queue.empty());
+
+    int value = -1;
+    for (int i = 0; i < 11; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.try_pop(value));
+    ASSERT_TRUE(queue.empty());
+}
+
+/*
+    push_n и try_pop_n перекладывают данные пачками, try_pop_n возвращает
+    ровно столько элементов, сколько было доступно.
+*/
+TEST(SpscUnrolledQueue, batchedPushAndPop) {
+    spsc_unrolled_queue<int, 5> queue;
+    std::vector<int> input(17);
+    for (int i = 0; i < 17; ++i) {
+        input[i] = i * 3;
+    }
+
+    ASSERT_EQ(queue.push_n(input.begin(), input.size()), 17);
+
+    std::vector<int> output;
+    ASSERT_EQ(queue.try_pop_n(std::back_inserter(output), 7), 7);
+    ASSERT_EQ(queue.try_pop_n(std::back_inserter(output), 100), 10);
+    ASSERT_EQ(queue.try_pop_n(std::back_inserter(output), 100), 0);
+    ASSERT_EQ(output, input);
+}
+
+/*
+    Прочитанные узлы переиспользуются: при постоянной глубине очереди
+    число аллокаций не растёт с числом операций.
+*/
+TEST(SpscUnrolledQueue, recyclesNodes) {
+    CountingAllocator<char>::AllocationCount = 0;
+    CountingAllocator<char>::DeallocationCount = 0;
+    {
+        spsc_unrolled_queue<int, 8, CountingAllocator<int>> queue;
+        int value = 0;
+        for (int round = 0; round < 1000; ++round) {
+            for (int i = 0; i < 20; ++i) {
+                queue.push(i);
+            }
+            for (int i = 0; i < 20; ++i) {
+                ASSERT_TRUE(queue.try_pop(value));
+            }
+        }
+        ASSERT_LE(CountingAllocator<char>::AllocationCount, 5);
+    }
+    ASSERT_EQ(CountingAllocator<char>::AllocationCount, CountingAllocator<char>::DeallocationCount);
+}
+
+/*
+    Деструктор разрушает непрочитанные элементы.
+*/
+TEST(SpscUnrolledQueue, destroysRemainingElements) {
+    Tracked::Alive = 0;
+    {
+        spsc_unrolled_queue<Tracked, 3> queue;
+        for (int i = 0; i < 10; ++i) {
+            queue.push(Tracked(i));
+        }
+        Tracked out(0);
+        ASSERT_TRUE(queue.try_pop(out));
+        ASSERT_TRUE(queue.try_pop(out));
+        ASSERT_TRUE(queue.try_pop(out));
+        ASSERT_TRUE(queue.try_pop(out));
+        ASSERT_EQ(out.Value, 3);
+    }
+    ASSERT_EQ(Tracked::Alive, 0);
+}
+
+/*
+    Производитель и потребитель в разных потоках: потребитель видит
+    все элементы ровно один раз и в исходном порядке.
+*/
+TEST(SpscUnrolledQueue, producerConsumerThreads) {
+    constexpr int count = 200000;
+    spsc_unrolled_queue<int, 32> queue;
+
+    std::thread producer([&queue] {
+        int batch[7];
+        int i = 0;
+        while (i < count) {
+            if (i % 3 == 0) {
+                int n = 0;
+                for (; n < 7 && i + n < count; ++n) {
+                    batch[n] = i + n;
+                }
+                queue.push_n(batch, n);
+                i += n;
+            } else {
+                queue.push(i++);
+            }
+        }
+    });
+
+    int expected = 0;
+    std::vector<int> buffer;
+    while (expected < count) {
+        buffer.clear();
+        queue.try_pop_n(std::back_inserter(buffer), 13);
+        for (int v : buffer) {
+            ASSERT_EQ(v, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(queue.empty());
+}
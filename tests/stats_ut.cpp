@@ -0,0 +1,123 @@
+#include <list_hooks.h>
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+namespace {
+
+struct counting_policy : unrolled_list_policy {
+    static constexpr bool count_operations = true;
+};
+
+}
+
+/*
+    stats() описывает заполненность узлов и расход памяти.
+*/
+TEST(Stats, fillAndBytes) {
+    unrolled_list<int, 4> list;
+    auto empty = list.stats();
+    ASSERT_EQ(empty.nodes, 0);
+    ASSERT_EQ(empty.min_fill, 0);
+    ASSERT_EQ(empty.avg_fill, 0.0);
+
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    list.insert(std::next(list.begin()), 42);
+
+    auto st = list.stats();
+    ASSERT_EQ(st.nodes, 4);
+    ASSERT_EQ(st.elements, 11);
+    ASSERT_EQ(st.min_fill, 2);
+    ASSERT_EQ(st.max_fill, 4);
+    ASSERT_DOUBLE_EQ(st.avg_fill, 11.0 / 4);
+    ASSERT_THAT(st.fill_histogram, testing::ElementsAre(0, 0, 2, 1, 1));
+    ASSERT_EQ(st.bytes_used, 11 * sizeof(int));
+    ASSERT_GE(st.bytes_allocated, 16 * sizeof(int));
+    ASSERT_EQ(st.counters.allocations, 0);
+}
+
+/*
+    Со включёнными счётчиками учитываются выделения и освобождения узлов,
+    сдвиги элементов и разбиения.
+*/
+TEST(Stats, operationCounters) {
+    unrolled_list<int, 4, std::allocator<int>, counting_policy> list;
+    for (int i = 0; i < 8; ++i) {
+        list.push_back(i);
+    }
+    list.push_front(-1);
+    list.push_front(-2);
+    list.insert(std::next(list.begin(), 5), 42);
+    list.pop_front();
+
+    auto st = list.stats();
+    ASSERT_EQ(st.counters.allocations, 4);
+    ASSERT_EQ(st.counters.splits, 1);
+    ASSERT_EQ(st.counters.shifts, 1 + 2 + 1 + 1);
+    ASSERT_EQ(st.counters.frees, 0);
+
+    list.clear();
+    ASSERT_EQ(list.stats().counters.frees, 4);
+}
+
+/*
+    Счётчики описывают историю узлов и переходят вместе с ними
+    при swap и перемещении.
+*/
+TEST(Stats, countersFollowNodes) {
+    using list_type = unrolled_list<int, 4, std::allocator<int>, counting_policy>;
+    list_type a;
+    list_type b;
+    for (int i = 0; i < 8; ++i) {
+        a.push_back(i);
+    }
+    b.push_back(0);
+
+    a.swap(b);
+    ASSERT_EQ(a.stats().counters.allocations, 1);
+    ASSERT_EQ(b.stats().counters.allocations, 2);
+
+    list_type c(std::move(b));
+    ASSERT_EQ(c.stats().counters.allocations, 2);
+    ASSERT_EQ(b.stats().counters.allocations, 0);
+
+    a = std::move(c);
+    ASSERT_EQ(a.stats().counters.allocations, 2);
+    ASSERT_EQ(a.stats().counters.frees, 0);
+    ASSERT_EQ(c.stats().counters.allocations, 0);
+}
+
+/*
+    deserialize() в непустой список добавляет свои выделения к счётчикам
+    и оставляет списку его объект хуков.
+*/
+TEST(Stats, deserializeKeepsCountersAndHooks) {
+    struct counted_and_hooked : counting_policy {
+        using hooks = counting_hooks;
+    };
+    using list_type = unrolled_list<int, 4, std::allocator<int>, counted_and_hooked>;
+    list_type source;
+    for (int i = 0; i < 20; ++i) {
+        source.push_back(i);
+    }
+    std::stringstream stream;
+    source.serialize(stream);
+
+    list_type list;
+    for (int i = 0; i < 40; ++i) {
+        list.push_back(-i);
+    }
+    ASSERT_EQ(list.stats().counters.allocations, 10);
+    ASSERT_EQ(list.hooks().count(unrolled_list_event::node_allocate), 10);
+
+    list.deserialize(stream);
+    ASSERT_EQ(list.size(), 20);
+    ASSERT_EQ(list.front(), 0);
+    ASSERT_EQ(list.stats().counters.allocations, 15);
+    ASSERT_EQ(list.hooks().count(unrolled_list_event::node_allocate), 10);
+}
@@ -0,0 +1,119 @@
+#include <bin/trace.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<trace_entry> parse(const std::string& text) {
+    std::istringstream in(text);
+    return read_trace(in);
+}
+
+std::string error_of(const std::string& text) {
+    try {
+        parse(text);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+}
+
+/*
+    Все виды операций читаются со своими аргументами; пустые строки
+    и комментарии пропускаются.
+*/
+TEST(Trace, readsOperations) {
+    auto trace = parse(
+        "# recorded trace\n"
+        "push_back 12\n"
+        "\n"
+        "push_front 3\n"
+        "insert 5 40\n"
+        "# erase next\n"
+        "erase 2\n"
+        "pop_back\n"
+        "pop_front\n"
+        "iterate\n");
+    ASSERT_EQ(trace.size(), 7);
+    ASSERT_EQ(trace[0].op, trace_op::push_back);
+    ASSERT_EQ(trace[0].payload, 12);
+    ASSERT_EQ(trace[1].op, trace_op::push_front);
+    ASSERT_EQ(trace[1].payload, 3);
+    ASSERT_EQ(trace[2].op, trace_op::insert);
+    ASSERT_EQ(trace[2].pos, 5);
+    ASSERT_EQ(trace[2].payload, 40);
+    ASSERT_EQ(trace[3].op, trace_op::erase);
+    ASSERT_EQ(trace[3].pos, 2);
+    ASSERT_EQ(trace[4].op, trace_op::pop_back);
+    ASSERT_EQ(trace[5].op, trace_op::pop_front);
+    ASSERT_EQ(trace[6].op, trace_op::iterate);
+
+    ASSERT_TRUE(parse("").empty());
+    ASSERT_TRUE(parse("\n# only comments\n\n").empty());
+}
+
+/*
+    Неизвестная операция и недостающий аргумент — исключение с номером
+    строки, считая пустые строки и комментарии.
+*/
+TEST(Trace, rejectsMalformedLines) {
+    ASSERT_THAT(error_of("push_back 1\nshuffle 3\n"), testing::HasSubstr("line 2: unknown operation 'shuffle'"));
+    ASSERT_THAT(error_of("# c\n\nPush_back 1\n"), testing::HasSubstr("line 3: unknown operation"));
+
+    ASSERT_THAT(error_of("push_back\n"), testing::HasSubstr("line 1: missing argument"));
+    ASSERT_THAT(error_of("iterate\npush_front x\n"), testing::HasSubstr("line 2: missing argument"));
+    ASSERT_THAT(error_of("insert 4\n"), testing::HasSubstr("line 1: missing argument"));
+    ASSERT_THAT(error_of("erase\n"), testing::HasSubstr("line 1: missing argument"));
+}
+
+/*
+    Операции, записанные write_trace_entry с payload из trace_payload (так
+    пишет трассу workload_gen --emit), читаются обратно без потерь: для
+    строк payload — длина самого значения, для других типов — sizeof(T).
+*/
+TEST(Trace, emittedTraceRoundTrips) {
+    std::vector<std::string> values;
+    for (std::uint64_t seed = 0; seed < 30; ++seed) {
+        values.push_back(std::string(8 + seed % 24, 'x'));
+    }
+    std::vector<trace_entry> written;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        trace_op op = i % 3 == 0 ? trace_op::push_back : i % 3 == 1 ? trace_op::push_front : trace_op::insert;
+        written.push_back({op, op == trace_op::insert ? i / 2 : 0, trace_payload(values[i])});
+        if (i % 5 == 4) {
+            written.push_back({trace_op::erase, i / 3});
+            written.push_back({trace_op::iterate});
+            written.push_back({trace_op::pop_back});
+            written.push_back({trace_op::pop_front});
+        }
+    }
+    written.push_back({trace_op::push_back, 0, trace_payload(std::uint64_t{7})});
+    written.push_back({trace_op::insert, 1, trace_payload(std::int32_t{7})});
+
+    std::stringstream out;
+    out << "# workload_gen --mix=middle --seed=1\n";
+    for (const trace_entry& entry : written) {
+        write_trace_entry(out, entry);
+    }
+    std::vector<trace_entry> read = read_trace(out);
+
+    ASSERT_EQ(read.size(), written.size());
+    for (std::size_t i = 0; i < read.size(); ++i) {
+        ASSERT_EQ(read[i].op, written[i].op) << i;
+        ASSERT_EQ(read[i].pos, written[i].pos) << i;
+        ASSERT_EQ(read[i].payload, written[i].payload) << i;
+    }
+    ASSERT_EQ(read[0].payload, 8);
+    ASSERT_EQ(read[1].payload, 9);
+    ASSERT_EQ(read[read.size() - 2].payload, sizeof(std::uint64_t));
+    ASSERT_EQ(read.back().payload, sizeof(std::int32_t));
+}
@@ -0,0 +1,119 @@
+#include <unrolled_deque.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+static_assert(std::random_access_iterator<unrolled_deque<int>::iterator>);
+static_assert(std::random_access_iterator<unrolled_deque<int>::const_iterator>);
+
+/*
+    Случайные операции с обоих концов сверяются с std::deque,
+    включая доступ по индексу и обход в обе стороны.
+*/
+TEST(UnrolledDeque, matchesStdDeque) {
+    std::mt19937 rng(3);
+    unrolled_deque<std::string, 4> deque;
+    std::deque<std::string> reference;
+
+    for (int step = 0; step < 20000; ++step) {
+        std::string val = std::to_string(step);
+        switch (rng() % 5) {
+        case 0:
+        case 1:
+            deque.push_back(val);
+            reference.push_back(val);
+            break;
+        case 2:
+            deque.push_front(val);
+            reference.push_front(val);
+            break;
+        case 3:
+            deque.pop_back();
+            if (!reference.empty()) reference.pop_back();
+            break;
+        case 4:
+            deque.pop_front();
+            if (!reference.empty()) reference.pop_front();
+            break;
+        }
+        ASSERT_EQ(deque.size(), reference.size());
+        if (!reference.empty()) {
+            std::size_t i = rng() % reference.size();
+            ASSERT_EQ(deque[i], reference[i]);
+            ASSERT_EQ(deque.front(), reference.front());
+            ASSERT_EQ(deque.back(), reference.back());
+        }
+    }
+    ASSERT_TRUE(std::equal(deque.begin(), deque.end(), reference.begin(), reference.end()));
+    ASSERT_TRUE(std::equal(deque.rbegin(), deque.rend(), reference.rbegin(), reference.rend()));
+    ASSERT_EQ(deque.end() - deque.begin(), static_cast<std::ptrdiff_t>(reference.size()));
+}
+
+/*
+    Итераторы произвольного доступа работают с алгоритмами, которым это
+    нужно, в том числе на границах узлов и у end().
+*/
+TEST(UnrolledDeque, randomAccessAlgorithms) {
+    unrolled_deque<int, 8> deque;
+    for (int i = 0; i < 64; ++i) {
+        deque.push_back(i * 2);
+    }
+    for (int i = 1; i <= 5; ++i) {
+        deque.push_front(-i * 2);
+    }
+
+    ASSERT_EQ(*std::lower_bound(deque.begin(), deque.end(), 31), 32);
+    ASSERT_EQ(std::lower_bound(deque.begin(), deque.end(), 1000), deque.end());
+    ASSERT_EQ(std::distance(deque.begin(), deque.end()), 69);
+
+    auto it = deque.begin() + 20;
+    ASSERT_EQ(*it, 30);
+    ASSERT_EQ(it[-20], -10);
+    ASSERT_EQ(*(it - 17), -4);
+    ASSERT_EQ(*(deque.end() - 1), 126);
+    ASSERT_EQ((deque.begin() + 69), deque.end());
+    ASSERT_TRUE(deque.begin() < it && it < deque.end());
+
+    std::reverse(deque.begin(), deque.end());
+    std::nth_element(deque.begin(), deque.begin() + 34, deque.end());
+    ASSERT_EQ(deque[34], 58);
+    std::sort(deque.begin(), deque.end());
+    ASSERT_TRUE(std::is_sorted(deque.begin(), deque.end()));
+    ASSERT_EQ(deque.front(), -10);
+}
+
+/*
+    Крайние узлы освобождаются, как только становятся пустыми;
+    внутренние узлы всегда заполнены.
+*/
+TEST(UnrolledDeque, nodesFullExceptEnds) {
+    unrolled_deque<int, 4> deque;
+    for (int i = 0; i < 16; ++i) {
+        deque.push_back(i);
+    }
+    ASSERT_EQ(deque.node_count(), 4);
+    deque.push_front(-1);
+    ASSERT_EQ(deque.node_count(), 5);
+    deque.pop_front();
+    ASSERT_EQ(deque.node_count(), 4);
+    for (int i = 0; i < 5; ++i) {
+        deque.pop_front();
+    }
+    ASSERT_EQ(deque.node_count(), 3);
+    ASSERT_EQ(deque.front(), 5);
+    ASSERT_EQ(deque.at(10), 15);
+    ASSERT_THROW(deque.at(11), std::out_of_range);
+
+    unrolled_deque<int, 4> copy = deque;
+    deque.clear();
+    ASSERT_EQ(deque.node_count(), 0);
+    ASSERT_EQ(deque.begin(), deque.end());
+    ASSERT_THAT(std::vector<int>(copy.begin(), copy.end()), testing::ElementsAre(5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
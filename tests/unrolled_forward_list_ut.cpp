@@ -0,0 +1,91 @@
+#include <unrolled_forward_list.h>
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <forward_list>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+    push_back, push_front и pop_front дают тот же порядок, что и std::forward_list;
+    before_begin() переходит в begin() и у пустого списка.
+*/
+TEST(UnrolledForwardList, ends) {
+    unrolled_forward_list<std::string, 3> list;
+    ASSERT_EQ(std::next(list.before_begin()), list.begin());
+    ASSERT_EQ(list.begin(), list.end());
+
+    for (int i = 0; i < 7; ++i) {
+        list.push_back(std::to_string(i));
+    }
+    list.push_front("a");
+    list.push_front("b");
+    list.pop_front();
+    ASSERT_EQ(list.size(), 8);
+    ASSERT_EQ(list.front(), "a");
+    ASSERT_EQ(list.back(), "6");
+    ASSERT_THAT(list, testing::ElementsAre("a", "0", "1", "2", "3", "4", "5", "6"));
+    ASSERT_EQ(std::next(list.before_begin()), list.begin());
+
+    unrolled_forward_list<std::string, 3> copy = list;
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(copy.size(), 8);
+    ASSERT_EQ(*std::next(copy.begin(), 7), "6");
+}
+
+/*
+    insert_after и erase_after в случайных местах совпадают с std::forward_list,
+    включая удаление диапазона.
+*/
+TEST(UnrolledForwardList, matchesForwardList) {
+    unrolled_forward_list<int, 4> list;
+    std::forward_list<int> expected;
+    std::size_t size = 0;
+    std::mt19937 gen(5);
+    for (int step = 0; step < 3000; ++step) {
+        std::size_t pos = gen() % (size + 1);
+        auto it = std::next(list.before_begin(), static_cast<std::ptrdiff_t>(pos));
+        auto ex = std::next(expected.before_begin(), static_cast<std::ptrdiff_t>(pos));
+        if (gen() % 3 != 0) {
+            auto res = list.insert_after(it, step);
+            expected.insert_after(ex, step);
+            ASSERT_EQ(*res, step);
+            ++size;
+        } else if (pos < size) {
+            auto res = list.erase_after(it);
+            auto ex_res = expected.erase_after(ex);
+            ASSERT_EQ(res == list.end(), ex_res == expected.end());
+            if (res != list.end()) {
+                ASSERT_EQ(*res, *ex_res);
+            }
+            --size;
+        }
+        ASSERT_EQ(list.size(), size);
+    }
+    ASSERT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+    auto first = std::next(list.begin(), 10);
+    auto res = list.erase_after(first, std::next(first, 30));
+    expected.erase_after(std::next(expected.begin(), 10), std::next(expected.begin(), 40));
+    ASSERT_EQ(*res, *std::next(expected.begin(), 11));
+    ASSERT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+}
+
+/*
+    Дописанный подряд список плотно заполняет узлы, а узел короче,
+    чем у unrolled_list, на указатель prev.
+*/
+TEST(UnrolledForwardList, smallerNodes) {
+    unrolled_forward_list<int, 10> forward;
+    unrolled_list<int, 10> list;
+    for (int i = 0; i < 100; ++i) {
+        forward.push_back(i);
+        list.push_back(i);
+    }
+    ASSERT_EQ(forward.node_count(), 10);
+    ASSERT_EQ(forward.bytes_allocated(), list.stats().bytes_allocated - 10 * sizeof(void*));
+}